@@ -31,19 +31,152 @@ The option --tiebreak is meant to produce a better histogram for the same optima
 With --tiebreak, the mean number of drops across all possibilities should always be monotonic.
 Use options --left or --right to further skew the argmin decision when the optimum is an interval.
 
+Per-floor drop costs can be supplied with --cost-file=path (F integers, floors 1..F) or in the
+parametric form --cost-param=c0,c1,p, i.e. cost(f) = c0 + round(c1 * (f / F)^p).
+Translation invariance is then lost, so the dense engine is used: V, A (and the summed cost S)
+are stored in flat arrays layered by interval width, and each width layer is swept in parallel.
+The minimax scan uses the monotonicity of the two branches (break branch nondecreasing and
+survive branch nonincreasing in the drop floor) to start at their crossover and prune outwards.
+With --objective=mean the expected cost (uniform limit floor) is minimized instead; that scan
+is exhaustive per state. The option --dense selects the dense engine also for unit costs.
+Each state costs 16 bytes (int V and A, long long S) and a level has (F + 1) (F + 2) / 2 states, so
+F = 10^4 needs about 800 MB per egg level; that bounds F for the dense engine.
+
+Travel costs (--travel-file=path with F integers for distances 1..F, or --travel-param=c0,c1,p)
+charge each drop by the distance from the previous drop floor. The state is then extended by the
+rig position, but after a drop the rig is always at the new lb or ub, so the extended table is two
+dense tables (one per side). Candidates dominated by a unit-cost lower bound are skipped.
+
+Floors that cannot be dropped from are given with --forbid=path (list of floors) or drawn at random
+with --forbid-random=fraction[,seed]. The allowed floors are kept in a bitset; candidate loops walk it
+keeping the current word (tAllowedWalk), and the crossover is searched on plain floors. A state is
+terminal once no allowed floor is left strictly inside (lb, ub), so f* is only localized to the gap
+between allowed floors.
+The option --bench-forbidden times the dense sweep for sparse to dense random forbidden sets (--seed=S).
+
+Noisy drops (--noise=p_break,p_survive) break at or below f* with probability p_break and survive
+above f* with probability p_survive. The expected drops are then minimized over the interval belief
+(e, lb, ub), and both this policy and the noise-free minimax policy are evaluated by Monte Carlo
+(--trials=N, --seed=S), reporting mean and max drops and the fraction localized at the true f*.
+
+With --droppers=k each round makes up to k simultaneous drops and the minimax number of rounds is
+reported instead of drops. The optimal rounds follow from nested capacities (widest interval per
+rounds and eggs), so the k-subsets are never enumerated.
+
+With --damage=step[,cap] every survived drop weakens the egg: at damage level d it breaks from floor a
+iff a > f* - step * d. The basket is a multiset of damage levels (eggs with equal damage are
+interchangeable), and state counts and timings are reported next to the pristine model.
+
+With --crack=c[,keep] a drop has three outcomes: it breaks below f*, cracks within c floors of f* and
+survives otherwise. A cracked egg is lost unless keep is 1. The (e, width) tables are filled with
+vectorizable loops, and drops are compared with the usual two outcomes.
+
+With --lies=k up to k drop outcomes may be wrong (Ulam's game; eggs are not limited). States are lie
+sequences of the remaining candidates, memoized with lower/upper bounds under mirroring and pruned by
+Berlekamp's volume bound. For F <= 1000 the policy is checked against every pattern of lies.
+
+With --unbounded f* has no upper bound and F only sets the largest f* reported (up to 10^9). An
+exponential or a reach-based ramp climbs until the first break, and the bounded minimax policy settles
+the last gap. Worst and mean drops are computed per gap in closed form from the reach R(e, d).
+
+With --lag=p the result of a drop is only known after the next p slots have been committed (a slot
+drops or idles). States are (e, width) plus the queue of in-flight drops relative to lb, stored densely;
+blocks are solved by value iteration, and minimax slots are compared with immediate feedback (p = 0).
+
+With --stages=r all drops of a stage are committed (and made at once) before any result is known.
+Capacities Cap(r, e, D) give the fewest worst-case drops for 1..r stages (1 stage is non-adaptive), and
+the schedules are reported with their mean drops next to the adaptive optimum.
+
+With --egg-cost=c every broken egg adds c to the cost of a run (a drop costs 1), and --buy-egg=price
+allows buying eggs once they run out. Minimax and mean cost policies are compared with the drops-only
+optimum, and --egg-cost-sweep=lo,hi traces the mean cost optimum over egg costs by its breakpoints.
+
+With --angles=A the threshold has two coordinates (height 0..F, angle 0..A), and an egg survives a
+probe iff it is below the threshold in both. Candidate sets are staircases, ranked densely up to mirror
+symmetry and solved by size in parallel, with the usual max / mean / histogram report.
+
+With --poset=chain|grid,A|tree,k|bench the configurations form a partial order of at most 64 elements
+(a chain of F, an F x A grid, a k-ary tree of F nodes) and the surviving ones are an unknown down-set.
+States are bitmasks of undetermined configurations per egg count; chains are checked against single_scan.
+
+With --buildings=F2,...,Fk the E eggs are shared by the building F and buildings F2..Fk. Static egg
+allocations minimize total or maximum drops by convolution over eggs of the per-building tables; the
+sequential search carries unbroken eggs over to the next building and tries all orders for k <= 6.
+
+With --quantile=p the p-quantile of the drops is minimized, under the uniform limit floor or the weights
+of floors 0..F read by --prior=path. Per state, the best mass localized within r drops is built from the
+children by shift and merge, keeping only the prefix below the state's minimax drops (F <= 500).
+With --drop-budget=D the same tables give the policy with the most prior mass localized within D drops
+and, in one sweep, the success probability versus D for every egg count.
+
+With --tolerance=k the limit floor need only be pinned to k + 1 floors: states of width <= k + 1 are
+terminal in every engine, and a single egg may drop up to k + 1 floors above lb. Drops settle at most
+(k + 1) (reach + 1) candidates, so the report adds the drops saved for tolerances 0..k (unit costs).
+
+With --prior-delta=path the expected drops under the prior (--prior=path, else uniform) are solved, the
+"floor weight" pairs of the file are applied, and only the states whose interval contains a changed floor
+are re-solved, in dependency order. The report counts re-solved states and changed actions and checks the
+result against a full re-solve.
+
+With --prior-batch=path (K priors of F + 1 weights) or --prior-random=K the expected drops of all priors
+are solved at once, one lane per prior in every state, and checked against K separate solves.
+
+With --tie-regret=path every state of the dense minimax tables gets the spread of the summed cost over
+its tied optimal drops, from V and S alone; the map is written as "DPTR", F, E and one int32 per state.
+
+With --mean-bounds the smallest and largest mean drops over all minimax-optimal policies are computed for
+every (f, e) by a budget DP over widths (unit costs), next to the narrower range of policies that use
+tied drops in every state, with witness executions of both extremes for (F, E).
+
+For embedding, tPolicy wraps solved dense tables immutably and tPolicyHandle swaps it read-copy-update
+style: readers announce an epoch in their own slot (wait-free lookups), retired policies are deleted once
+no reader can hold them. --policy-swap=N runs readers against N swaps of alternating policies.
+
+With --surface=path[,wmax] the minimax and mean decision curves of every state up to width wmax are
+computed in parallel from the dense tables and written as a binary file with one chunk per (e, width)
+and an index of chunk offsets.
+
+With --audit=path a memory-mapped log of executions (32-bit words floor << 2 | broke << 1 | end) is
+replayed against the dense tables, split across threads at execution boundaries. A drop is non-optimal
+if its worst case exceeds V of its state (tied drops are optimal); wasted drops, executions that run out
+of eggs, contradict earlier outcomes or stop early, and the cost above V are counted separately.
+--audit-generate=N[,fault] writes the log first from the policy, with random faults at the given rate.
+
 BUILD:
 
-  g++ -O2 -Wall -o dpegg dpegg.cpp
-  clang++ -O2 -Wall -o dpegg dpegg.cpp
+  g++ -O2 -Wall -pthread -o dpegg dpegg.cpp
+  clang++ -O2 -Wall -pthread -o dpegg dpegg.cpp
 
 USAGE:
-  ./dpegg F E [--tiebreak]
+  ./dpegg F E [--tiebreak --left --right]
+  ./dpegg F E [--cost-file=path | --cost-param=c0,c1,p] [--objective=minimax|mean] [--dense] [--threads=N]
+  ./dpegg F E [--travel-file=path | --travel-param=c0,c1,p] [--objective=minimax|mean] [--threads=N]
+  ./dpegg F E [--forbid=path | --forbid-random=fraction[,seed]] [--bench-forbidden [--seed=S]] ...
+  ./dpegg F E --noise=p_break,p_survive [--trials=N --seed=S --threads=N]
+  ./dpegg F E --droppers=k
+  ./dpegg F E --damage=step[,cap]
+  ./dpegg F E --crack=c[,keep]
+  ./dpegg F E --lies=k
+  ./dpegg F E --unbounded
+  ./dpegg F E --lag=p [--threads=N]
+  ./dpegg F E --stages=r
+  ./dpegg F E --egg-cost=c [--buy-egg=price] [--egg-cost-sweep=lo,hi]
+  ./dpegg F E --angles=A [--threads=N]
+  ./dpegg F E --poset=chain|grid,A|tree,k|bench
+  ./dpegg F E --buildings=F2,...,Fk
+  ./dpegg F E --quantile=p [--prior=path] [--threads=N]
+  ./dpegg F E --drop-budget=D [--prior=path] [--threads=N]
+  ./dpegg F E --tolerance=k [standard, dense or cost model options]
+  ./dpegg F E --prior-delta=path [--prior=path] [--threads=N]
+  ./dpegg F E --prior-batch=path | --prior-random=K [--seed=S] [--threads=N]
+  ./dpegg F E --tie-regret=path [--cost-file=path | --cost-param=c0,c1,p] [--threads=N]
+  ./dpegg F E --mean-bounds [--threads=N]
+  ./dpegg F E --policy-swap=N [--threads=N] [--seed=S]
+  ./dpegg F E --surface=path[,wmax] [dense or cost model options]
+  ./dpegg F E --audit=path [--audit-generate=N[,fault]] [--seed=S] [--threads=N]
 
 */
 
-// TODO: some sort of "minimizing interval" binary search is required to scale to large F
-//       perhaps also store optimal drop range [f1, f2] for each decision node?
-
 #include <iostream>
 #include <iomanip>
 #include <vector>
@@ -52,6 +185,20 @@ USAGE:
 #include <string>
 #include <algorithm>
 #include <chrono>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <climits>
+#include <cmath>
+#include <random>
+#include <mutex>
+#include <limits>
+#include <numeric>
+#include <atomic>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 int classic_dpegg_limit(int F, int E) {
   std::map<std::vector<int>, int> reach;  // reach[{d, e}] = max reachable with d drops and e eggs
@@ -72,37 +219,74 @@ int classic_dpegg_limit(int F, int E) {
 
 struct tState {
 
+  // the rig position is not part of the identity; it only matters for the travel cost model
   bool operator==(const tState& rhs) const {
     return (eggs == rhs.eggs && lb == rhs.lb && ub == rhs.ub);
   }
 
+  // terminal when no (allowed) drop floor is left strictly between lb and ub, or when the
+  // interval is already within the tolerance
   bool isterminal() const {
-    return (ub == lb + 1 && lb >= 0 && eggs >= 0);
+    return ((next_allowed(lb + 1) >= ub || ub - lb <= tolerance + 1) && lb >= 0 && eggs >= 0);
   }
 
   bool isfailed() const {
-    return (eggs < 0 || (eggs == 0 && ub > lb + 1));
+    return (eggs < 0 || (eggs == 0 && next_allowed(lb + 1) < ub && ub - lb > tolerance + 1));
+  }
+
+  // Smallest allowed drop floor >= f, scanning the bitset of allowed floors a word at a time.
+  // Bits 0 and F + 1 are set as sentinels, so the scan always stops at F + 1 at the latest.
+  static int next_allowed(int f) {
+    if (allowed_floor.empty())
+      return f;
+    size_t k = f >> 6;
+    if (k >= allowed_floor.size())
+      return f;
+    uint64_t word = allowed_floor[k] & (~0ULL << (f & 63));
+    while (word == 0)
+      word = allowed_floor[++k];
+    return static_cast<int>((k << 6) + __builtin_ctzll(word));
+  }
+
+  // Largest allowed drop floor <= f for 0 <= f <= F + 1 (0 if there is none)
+  static int prev_allowed(int f) {
+    if (allowed_floor.empty())
+      return f;
+    size_t k = f >> 6;
+    uint64_t word = allowed_floor[k] & (~0ULL >> (63 - (f & 63)));
+    while (word == 0)
+      word = allowed_floor[--k];
+    return static_cast<int>((k << 6) + 63 - __builtin_clzll(word));
   }
 
   bool eggdrop(int floor, int limit) {
     const bool breaks = (floor > limit);
+    observe(floor, breaks);
+    return breaks;
+  }
+
+  // update with an observed outcome (which need not agree with the limit floor when drops are noisy)
+  void observe(int floor, bool breaks) {
+    at = floor;
     if (breaks) {
       eggs--;
       if (floor < ub) ub = floor;
     } else {
       if (floor > lb) lb = floor;
     }
-    return breaks;
   }
 
   tState next(int floor, int limit) const {
-    tState state = {this->eggs, this->lb, this->ub};
+    tState state = *this;
     state.eggdrop(floor, limit);
     return state;    
   }
 
   int cost(int floor, int limit) const {
-    return 1; // usual cost is 1 drop, independent of the floor dropped from
+    if (floor_cost.empty() && travel_cost.empty())
+      return 1; // usual cost is 1 drop, independent of the floor dropped from
+    return (floor_cost.empty() ? 0 : floor_cost[floor]) + 
+           (travel_cost.empty() ? 0 : travel_cost[std::abs(floor - at)]);
   }
 
   friend std::ostream& operator<<(std::ostream& os, const tState& s);
@@ -110,8 +294,68 @@ struct tState {
   int eggs;
   int lb;
   int ub; 
+  int at = 0;  // floor of the previous drop (0 = ground), always lb or ub after a drop
+
+  static std::vector<int> floor_cost;  // optional cost per floor (index 0 unused); empty means unit cost
+  static std::vector<int> travel_cost; // optional cost per distance moved from the previous drop floor
+  static std::vector<uint64_t> allowed_floor;  // optional bitset of the floors that can be dropped from
+  static int tolerance;  // the limit floor need only be pinned to an interval of tolerance + 1 floors
+};
+
+std::vector<int> tState::floor_cost;
+std::vector<int> tState::travel_cost;
+std::vector<uint64_t> tState::allowed_floor;
+int tState::tolerance = 0;
+
+// Walk over the allowed drop floors from a start floor, upwards or downwards. The current bitset word is
+// kept between steps, so a step clears one bit and only reloads when the word runs out. Without forbidden
+// floors the walk is a plain increment. The sentinel bits 0 and F + 1 stop the walk at the building ends.
+struct tAllowedWalk {
+  tAllowedWalk(int f, bool up) : floor(f), upwards(up), k(f >> 6), word(0) {
+    if (tState::allowed_floor.empty())
+      return;
+    word = tState::allowed_floor[k] & (upwards ? ~0ULL << (f & 63) : ~0ULL >> (63 - (f & 63)));
+    settle();
+  }
+
+  void next() {
+    if (tState::allowed_floor.empty()) {
+      floor += (upwards ? 1 : -1);
+      return;
+    }
+    word &= ~(1ULL << (floor & 63));
+    settle();
+  }
+
+  int floor;
+
+private:
+  void settle() {
+    while (word == 0)
+      word = tState::allowed_floor[upwards ? ++k : --k];
+    floor = static_cast<int>((k << 6) + (upwards ? __builtin_ctzll(word) : 63 - __builtin_clzll(word)));
+  }
+
+  bool upwards;
+  size_t k;
+  uint64_t word;
 };
 
+// Build the bitset of allowed drop floors 1..F from a list of forbidden floors (an empty list clears it)
+void set_forbidden_floors(int F, const std::vector<int>& forbidden)
+{
+  tState::allowed_floor.clear();
+  if (forbidden.empty())
+    return;
+  tState::allowed_floor.assign(((F + 1) >> 6) + 1, 0);
+  for (int f = 0; f <= F + 1; f++)
+    tState::allowed_floor[f >> 6] |= (1ULL << (f & 63));
+  for (int f : forbidden) {
+    if (f >= 1 && f <= F)
+      tState::allowed_floor[f >> 6] &= ~(1ULL << (f & 63));
+  }
+}
+
 namespace std {
   template <>
   struct hash<tState> {
@@ -130,21 +374,141 @@ std::ostream& operator<<(std::ostream& os, const tState& s) {
   return os;
 }
 
+// Dense table over all states (e, lb, ub) with 0 <= e <= E and 0 <= lb < ub <= F + 1.
+// Only e >= 1 is stored; with no eggs left only the terminal states exist (and they hold zero).
+// The layout is (e, width, lb) so that all states of one width form a contiguous layer;
+// a layer only depends on narrower layers (and on the level e - 1), so it can be swept in parallel.
+template <typename TE>
+struct tDense {
+
+  void resize(int F_, int E_, TE fill) {
+    F = F_;
+    E = E_;
+    per_level = static_cast<size_t>(F + 1) * (F + 2) / 2;
+    data.assign(per_level * E, fill);
+  }
+
+  size_t index(int e, int lb, int ub) const {
+    const size_t w = ub - lb;
+    return (e - 1) * per_level + (w - 1) * (F + 2) - (w - 1) * w / 2 + lb;
+  }
+
+  TE& at(int e, int lb, int ub) {
+    return data[index(e, lb, ub)];
+  }
+
+  TE at(int e, int lb, int ub) const {
+    return data[index(e, lb, ub)];
+  }
+
+  bool find(const tState& s, TE& x) const {
+    if (s.eggs < 0 || s.eggs > E || s.lb < 0 || s.lb >= s.ub || s.ub > F + 1)
+      return false;
+    if (s.eggs == 0) {
+      x = 0;
+      return s.isterminal();
+    }
+    x = at(s.eggs, s.lb, s.ub);
+    return true;
+  }
+
+  size_t size() const {
+    return data.size();
+  }
+
+  int F;
+  int E;
+  size_t per_level;
+  std::vector<TE> data;
+};
+
+// Uniform lookup for the hash map tables and the dense tables
+bool table_find(const std::unordered_map<tState, int>& T, const tState& s, int& x) {
+  const auto search = T.find(s);
+  if (search == T.end())
+    return false;
+  x = search->second;
+  return true;
+}
+
+template <typename TE>
+bool table_find(const tDense<TE>& T, const tState& s, TE& x) {
+  return T.find(s, x);
+}
+
+// Dense tables for the travel cost model, where the state is extended by the rig position.
+// After any drop the rig is at the new lb (survived) or the new ub (broke), and it starts at lb = 0,
+// so the position reduces to a side bit and the extended table is just two dense tables.
+template <typename TE>
+struct tSided {
+
+  void resize(int F, int E, TE fill) {
+    side[0].resize(F, E, fill);
+    side[1].resize(F, E, fill);
+  }
+
+  TE& at(int k, int e, int lb, int ub) {
+    return side[k].at(e, lb, ub);
+  }
+
+  TE at(int k, int e, int lb, int ub) const {
+    return side[k].at(e, lb, ub);
+  }
+
+  bool find(const tState& s, TE& x) const {
+    return side[s.at == s.ub ? 1 : 0].find(s, x);
+  }
+
+  size_t size() const {
+    return side[0].size() + side[1].size();
+  }
+
+  tDense<TE> side[2];
+};
+
+template <typename TE>
+bool table_find(const tSided<TE>& T, const tState& s, TE& x) {
+  return T.find(s, x);
+}
+
+// Split [begin, end) into contiguous chunks and call body(chunk_begin, chunk_end) on up to nthreads threads.
+// Small ranges are run on the calling thread.
+template <typename TF>
+void parallel_for(int begin, int end, int nthreads, TF body, int min_chunk = 256)
+{
+  const int n = end - begin;
+  const int nchunks = std::min(nthreads, n / min_chunk);
+  if (nchunks <= 1) {
+    body(begin, end);
+    return;
+  }
+  std::vector<std::thread> workers;
+  for (int t = 0; t < nchunks; t++) {
+    const int b = begin + static_cast<int>(static_cast<long long>(n) * t / nchunks);
+    const int e = begin + static_cast<int>(static_cast<long long>(n) * (t + 1) / nchunks);
+    workers.emplace_back(body, b, e);
+  }
+  for (auto& worker : workers)
+    worker.join();
+}
+
 // Run optimal policy once and return number of drops required to localize the limit floor L
+// (or rather the total drop cost, which is the number of drops unless floor costs are given)
+template <typename TA>
 int run_policy_once(int F, 
                     int E, 
                     int L, 
-                    const std::unordered_map<tState, int>& A,
+                    const TA& A,
                     std::vector<int>* aseq = nullptr)
 {
   if (aseq != nullptr) aseq->clear();
   tState s = {E, 0, F + 1};
   int steps = 0;
   while (!s.isterminal()) {
-    const auto s_search = A.find(s);
-    const int a = s_search->second;
+    int a = 0;
+    table_find(A, s, a);
+    steps += s.cost(a, L);
     s.eggdrop(a, L);
-    steps++;
     if (aseq != nullptr) aseq->push_back(a);
   }
   return steps;
@@ -154,10 +518,11 @@ int run_policy_once(int F,
 // Check that the worst case is indeed equal to the value stored in V, and also compute the mean number of drops.
 // Optionally build histogram D across the floors, where the drops are done.
 // Optionally build a histogram H of number of steps across all possible limit floors.
+template <typename TV, typename TA>
 bool check_policy(int F, 
                   int E,
-                  const std::unordered_map<tState, int>& V,
-                  const std::unordered_map<tState, int>& A,
+                  const TV& V,
+                  const TA& A,
                   int& max_drops,
                   double& mean_drops,
                   std::vector<int>* D = nullptr,
@@ -172,10 +537,10 @@ bool check_policy(int F,
     H->clear();
   std::vector<int> aseq;
   const tState s = {E, 0, F + 1};
-  const auto s_search = V.find(s);
-  const int nominal_value = s_search->second;
+  int nominal_value = 0;
+  table_find(V, s, nominal_value);
   int max_steps = 0;
-  int sum_steps = 0;
+  long long sum_steps = 0;
   for (int l = 0; l <= F; l++) {  
     const int actual = run_policy_once(F, E, l, A, &aseq);
     if (H != nullptr)
@@ -192,19 +557,20 @@ bool check_policy(int F,
   return (max_drops == nominal_value);
 }
 
+template <typename TA>
 int total_policy_at(const tState& snaught,
                     int action,
-                    const std::unordered_map<tState, int>& A)
+                    const TA& A)
 {
   int total_steps = 0;
   for (int l = snaught.lb; l < snaught.ub; l++) {
     tState s = snaught.next(action, l);
-    int steps = 1;
+    int steps = snaught.cost(action, l);
     while (!s.isterminal()) {
-      const auto s_search = A.find(s);
-      const int a = s_search->second;
+      int a = 0;
+      table_find(A, s, a);
+      steps += s.cost(a, l);
       s.eggdrop(a, l);
-      steps++;
     }
     total_steps += steps;
   }
@@ -233,20 +599,21 @@ int argmin_which(const std::vector<TV>& v, bool left, bool right) {
   return ties[ties.size() >> 1];
 }
 
+template <typename TV>
 bool calc_maximum_value(const tState& s, 
                         int action,
-                        const std::unordered_map<tState, int>& V,
+                        const TV& V,
                         int& max)
 {
   int max_along_f = -1;
   bool all_ok = true;
   for (int f = s.lb; f < s.ub; f++) {
     tState nextState = s.next(action, f);
-    auto search = V.find(nextState);
-    bool this_ok = (search != V.end());
+    int next_value = 0;
+    bool this_ok = table_find(V, nextState, next_value);
     all_ok = all_ok && this_ok;
     if (!all_ok) break;
-    const int this_value = s.cost(action, f) + search->second;
+    const int this_value = s.cost(action, f) + next_value;
     if (this_value > max_along_f)
       max_along_f = this_value;
   }
@@ -255,13 +622,14 @@ bool calc_maximum_value(const tState& s,
 }
 
 // An action is admissible if it can lead to a solution (i.e. not using all eggs inconclusively)
+template <typename TV>
 void find_admissible_actions(const tState& s, 
-                             const std::unordered_map<tState, int>& V,
+                             const TV& V,
                              std::vector<int>& actions,
                              std::vector<int>& values,
                              bool break_on_increase)
 {
-  for (int a = s.lb + 1; a < s.ub; a++) {
+  for (int a = tState::next_allowed(s.lb + 1); a < s.ub; a = tState::next_allowed(a + 1)) {
     int themax = -1;
     const bool ok = calc_maximum_value(s, a, V, themax);
     if (!ok || themax == -1)
@@ -275,9 +643,11 @@ void find_admissible_actions(const tState& s,
   }
 }
 
+template <typename TV, typename TA = std::unordered_map<tState, int>>
 void print_all_admissible(const tState& s, 
-                          const std::unordered_map<tState, int>& V,
-                          const std::unordered_map<tState, int>* A = nullptr)
+                          const TV& V,
+                          const TA* A = nullptr,
+                          const tDense<long long>* S = nullptr)
 {
   std::vector<int> a;
   std::vector<int> v;
@@ -296,7 +666,17 @@ void print_all_admissible(const tState& s,
     return;
   std::cout << "means: ";
   for (int a_ : a) {       
-    std::cout << " " << static_cast<double>(total_policy_at(s, a_, *A)) / (s.ub - s.lb);
+    if (S != nullptr) {
+      // summed cost of the subtrees is tabulated; no need to simulate the policy
+      long long below = 0;
+      long long above = 0;
+      S->find(s.next(a_, s.lb), below);
+      S->find(s.next(a_, s.ub - 1), above);
+      const long long total = static_cast<long long>(s.ub - s.lb) * s.cost(a_, s.lb) + below + above;
+      std::cout << " " << static_cast<double>(total) / (s.ub - s.lb);
+    } else {
+      std::cout << " " << static_cast<double>(total_policy_at(s, a_, *A)) / (s.ub - s.lb);
+    }
   }
   std::cout << std::endl;
 }
@@ -307,7 +687,10 @@ void initialize_terminal_nodes(int F,
 {
   for (int e = 0; e <= E; e++) {
     for (int f = 0; f <= F; f++) {
-      V.insert({{e, f, f + 1}, 0});
+      // with forbidden floors or a tolerance the terminal intervals can be wider than one floor
+      const int umax = std::min(std::max(tState::next_allowed(f + 1), f + tState::tolerance + 1), F + 1);
+      for (int u = f + 1; u <= umax; u++)
+        V.insert({{e, f, u}, 0});
     }
   }
 }
@@ -355,7 +738,7 @@ void single_scan(int F,
           continue;
         }
 
-        if (thisState.eggs == 1) {
+        if (thisState.eggs == 1 && tState::tolerance == 0) {
           if (local_val.size() != 1)
             std::cout << "there should be exactly 1 admissible drop with 1 egg to-go" << std::endl;
         }
@@ -428,160 +811,4921 @@ void single_scan(int F,
   }
 }
 
-std::string histogram_to_string(const std::unordered_map<int, int>& H, int kmin, int kmax) {
-  std::string s = "";
-  for (int k = kmin; k <= kmax; k++) {
-    const auto search = H.find(k);
-    if (search == H.end())
-      s += "0 ";
-    else
-      s += std::to_string(search->second) + " ";
-  }
-  return s;
-}
-
-int as_integer(const char* str) {
-  return static_cast<int>(std::strtol(str, nullptr, 0));
-}
-
-/*****************************************************************************/
+struct tDenseConfig {
+  bool minimize_mean;  // expected (summed) cost instead of the worst case
+  bool use_tiebreak;
+  bool pick_left;
+  bool pick_right;
+  int min_cost;        // smallest drop cost in the building, used for pruning
+  int nthreads;
+};
 
-int main(int argc, char** argv)
+// Solve a single non-terminal state (e, lb, ub) of the dense engine.
+// All narrower states at level e and all states at level e - 1 must be solved already.
+// V holds the worst case cost of the selected policy, S the cost summed over all limit floors lb..ub-1.
+void dense_solve_state(int e, 
+                       int lb, 
+                       int ub,
+                       const tDenseConfig& cfg,
+                       tDense<int>& V,
+                       tDense<int>& A,
+                       tDense<long long>& S,
+                       std::vector<int>& ties)
 {
-  if (argc < 3) {
-    std::cout << "usage: " << argv[0] << " F E [--tiebreak --left --right]" << std::endl;
-    return 1;
-  }
+  const tState s = {e, lb, ub};
+  const long long w = ub - lb;
 
-  const int F = as_integer(argv[1]);
-  const int E = as_integer(argv[2]);
-
-  if (F <= 0 || E <= 0) {
-    std::cout << "invalid input(s): F, E >= 1 required" << std::endl;
-    return 1;
+  if (s.isterminal()) {
+    V.at(e, lb, ub) = 0;
+    S.at(e, lb, ub) = 0;
+    A.at(e, lb, ub) = lb;
+    return;
   }
 
-  bool use_tiebreak = false;
-  bool pick_left = false;
-  bool pick_right = false;
-
-  for (int i = 3; i < argc; i++) {
-    if (std::string(argv[i]) == "--tiebreak")
-      use_tiebreak = true;
-    else if (std::string(argv[i]) == "--left")
-      pick_left = true;
-    else if (std::string(argv[i]) == "--right")
-      pick_right = true;
-    else {
-      std::cout << "invalid input: \"" << argv[i] << "\"" << std::endl;
-      return 1;  
+  if (!tState::allowed_floor.empty() && tState::tolerance == 0 && !cfg.minimize_mean && !cfg.use_tiebreak) {
+    // The minimax value and action only depend on the allowed floors inside (lb, ub), so a state whose end
+    // floors border forbidden ones copies the narrowest state with the same allowed floors (already solved).
+    // The summed cost still depends on the width and follows from the children.
+    const int lb_in = tState::next_allowed(lb + 1) - 1;
+    const int ub_in = tState::prev_allowed(ub - 1) + 1;
+    if (lb_in > lb || ub_in < ub) {
+      const int action = A.at(e, lb_in, ub_in);
+      V.at(e, lb, ub) = V.at(e, lb_in, ub_in);
+      S.at(e, lb, ub) = w * s.cost(action, lb) + (e > 1 ? S.at(e - 1, lb, action) : 0) + S.at(e, action, ub);
+      A.at(e, lb, ub) = action;
+      return;
     }
   }
 
-  if (pick_left && pick_right) {
-    std::cout << "cannot specify both --left and --right" << std::endl;
-    return 1;
+  if (e == 1) {
+    // a single egg left must not break inconclusively: drop right above lb, or anywhere up to the
+    // tolerance (the farthest of the best such drops)
+    tAllowedWalk walk(lb + 1, true);
+    int a = walk.floor;
+    for (walk.next(); walk.floor < ub && tState({0, lb, walk.floor}).isterminal(); walk.next()) {
+      const int b = walk.floor;
+      if (cfg.minimize_mean ? w * s.cost(b, lb) + S.at(e, b, ub) <= w * s.cost(a, lb) + S.at(e, a, ub)
+                            : s.cost(b, lb) + V.at(e, b, ub) <= s.cost(a, lb) + V.at(e, a, ub))
+        a = b;
+    }
+    const int c = s.cost(a, lb);
+    V.at(e, lb, ub) = c + V.at(e, a, ub);
+    S.at(e, lb, ub) = w * c + S.at(e, a, ub);
+    A.at(e, lb, ub) = a;
+    return;
   }
 
-  // parrot this call for later reference
-  for (int i = 0; i < argc; i++)
-    std::cout << argv[i] << " ";
-  std::cout << std::endl;
-
-  std::cout << "--- required min. number of drops = " << classic_dpegg_limit(F, E) << std::endl;
-
-  std::unordered_map<tState, int> V; // "value function"
-  std::unordered_map<tState, int> A; // "control action"
-
-  auto clock_start = std::chrono::high_resolution_clock::now();
+  ties.clear();
 
-  initialize_terminal_nodes(F, E, V);
- 
-  for (int e = 1; e <= E; e++) {
-    for (int s = 0; ; s++) {
-      int inserts = 0;
-      int modifies = 0;
-      single_scan(F, e, e, V, A, inserts, modifies, use_tiebreak, pick_left, pick_right);
-      //std::cout << "[e = " << e << ", scan = " << s << "]: " << "inserts = " << inserts << ", modifies = " << modifies << std::endl;
-      if (inserts == 0 && modifies == 0) {
-        std::cout << s + 1 << " scans at level e = " << e << std::endl;
+  if (!cfg.minimize_mean) {
+    // The break branch V(e - 1, lb, a) is nondecreasing in a and the survive branch V(e, a, ub) is nonincreasing.
+    // Locate their crossover k; above k the max is the break branch, below k it is the survive branch.
+    // Moving away from k the dominating branch only grows, so stop once it alone (plus the cheapest drop) 
+    // exceeds the best value found.
+    // Both branches are monotone over all floors, forbidden or not, so the crossover is searched on plain
+    // floors and moved to the next allowed one; the last allowed floor always satisfies the condition.
+    int lo = lb + 1;
+    int hi = ub - 1;
+    while (lo < hi) {
+      const int mid = (lo + hi) >> 1;
+      if (V.at(e - 1, lb, mid) >= V.at(e, mid, ub))
+        hi = mid;
+      else
+        lo = mid + 1;
+    }
+    lo = tState::next_allowed(lo);
+    int best = INT_MAX;
+    for (tAllowedWalk walk(lo, true); walk.floor < ub; walk.next()) {
+      const int a = walk.floor;
+      const int vb = V.at(e - 1, lb, a);
+      if (vb + cfg.min_cost > best)
+        break;
+      const int value = s.cost(a, lb) + vb;
+      if (value < best) {
+        best = value;
+        ties.clear();
+      }
+      if (value == best)
+        ties.push_back(a);
+    }
+    for (tAllowedWalk walk(lo - 1, false); walk.floor > lb; walk.next()) {
+      const int a = walk.floor;
+      const int vs = V.at(e, a, ub);
+      if (vs + cfg.min_cost > best)
         break;
+      const int value = s.cost(a, lb) + vs;
+      if (value < best) {
+        best = value;
+        ties.clear();
+      }
+      if (value == best)
+        ties.push_back(a);
+    }
+    std::sort(ties.begin(), ties.end());
+  } else {
+    long long best = LLONG_MAX;
+    for (tAllowedWalk walk(lb + 1, true); walk.floor < ub; walk.next()) {
+      const int a = walk.floor;
+      const long long total = w * s.cost(a, lb) + S.at(e - 1, lb, a) + S.at(e, a, ub);
+      if (total < best) {
+        best = total;
+        ties.clear();
       }
+      if (total == best)
+        ties.push_back(a);
     }
   }
 
-  auto clock_end = std::chrono::high_resolution_clock::now();
-  std::chrono::duration<double> clock_diff = clock_end - clock_start;
+  int action = ties[ties.size() >> 1];
+  if (cfg.use_tiebreak && ties.size() > 1) {
+    // secondary objective among the ties: summed cost for minimax, worst case for mean
+    std::vector<long long> ties_totals;
+    for (int a : ties) {
+      if (cfg.minimize_mean)
+        ties_totals.push_back(s.cost(a, lb) + std::max(V.at(e - 1, lb, a), V.at(e, a, ub)));
+      else
+        ties_totals.push_back(w * s.cost(a, lb) + S.at(e - 1, lb, a) + S.at(e, a, ub));
+    }
+    action = ties[argmin_which<long long>(ties_totals, cfg.pick_left, cfg.pick_right)];
+  } else {
+    if (cfg.pick_left)
+      action = ties[0];
+    else if (cfg.pick_right)
+      action = ties[ties.size() - 1];
+  }
 
-  std::cout << std::setprecision(6);
+  const int c = s.cost(action, lb);
+  V.at(e, lb, ub) = c + std::max(V.at(e - 1, lb, action), V.at(e, action, ub));
+  S.at(e, lb, ub) = w * c + S.at(e - 1, lb, action) + S.at(e, action, ub);
+  A.at(e, lb, ub) = action;
+}
 
-  std::cout << "value (action) table has " << V.size() << " (" << A.size() 
-            << ") entries (duration = " << clock_diff.count() << " s.)" << std::endl;
+// Dense replacement for the repeated single_scan: one sweep per egg level, by increasing width.
+// The states of one width are independent and are split across threads.
+void dense_scan(int F,
+                int E,
+                const tDenseConfig& cfg,
+                tDense<int>& V,
+                tDense<int>& A,
+                tDense<long long>& S,
+                int verbosity = 0)
+{
+  V.resize(F, E, 0);
+  A.resize(F, E, 0);
+  S.resize(F, E, 0);
 
-  std::unordered_map<int, int> histo;
-  std::vector<std::vector<int>> drops;
-  int max_drops;
-  double mean_drops;
+  for (int e = 1; e <= E; e++) {
+    for (int f = 0; f <= F; f++)
+      A.at(e, f, f + 1) = f;
+    for (int w = 2; w <= F + 1; w++) {
+      parallel_for(0, F + 2 - w, cfg.nthreads, [&](int lb_begin, int lb_end) {
+        std::vector<int> ties;
+        for (int lb = lb_begin; lb < lb_end; lb++)
+          dense_solve_state(e, lb, lb + w, cfg, V, A, S, ties);
+      });
+    }
+    if (verbosity > 0)
+      std::cout << "level e = " << e << " swept (" << V.per_level << " states)" << std::endl;
+  }
+}
 
-  drops.emplace_back();
+// Unit cost minimax drops D[e][w] for e = 0..E and widths w = 1..F+1, from the classic reach recursion.
+// With a tolerance every candidate of the exact search stands for tolerance + 1 floors.
+void unit_minimax_table(int F, int E, std::vector<std::vector<int>>& D)
+{
+  const long long t = tState::tolerance + 1;
+  D.assign(E + 1, std::vector<int>(F + 2, INT_MAX));
+  for (int e = 0; e <= E; e++) {
+    for (long long w = 1; w <= std::min<long long>(t, F + 1); w++)
+      D[e][w] = 0;
+  }
+  std::vector<long long> reach(E + 1, 0);  // reach[e] = floors resolvable with d drops
+  std::vector<long long> prev;
+  for (int d = 1; ; d++) {
+    prev = reach;
+    bool done = true;
+    for (int e = 1; e <= E; e++) {
+      reach[e] = std::min<long long>(F, prev[e - 1] + 1 + prev[e]);
+      for (long long w = t * (prev[e] + 1) + 1; w <= std::min<long long>(t * (reach[e] + 1), F + 1); w++)
+        D[e][w] = d;
+      if (reach[e] < F)
+        done = false;
+    }
+    if (done)
+      break;
+  }
+}
 
-  for (int e = 1; e <= E; e++) {
+// Minimal external path length of a binary tree with w leaves, i.e. a lower bound on the drops
+// summed over the w limit floors of an interval of width w
+long long min_path_length(long long w)
+{
+  int k = 0;
+  while ((2LL << k) <= w)
+    k++;
+  return w * k + 2 * (w - (1LL << k));
+}
 
-    drops.emplace_back();
+// Solve state (e, lb, ub) of the travel cost model with the rig at lb (side k = 0) or at ub (k = 1).
+// A drop at a moves the rig to a; the break branch then has the rig at its ub, the survive branch at its lb.
+// Branch values are not monotone in a here, so every candidate is first bounded from below with the 
+// unit cost tables (D and min_path_length scaled by the cheapest drop) and only evaluated if not dominated.
+// The unit cost bounds are taken at the effective width, i.e. one more than the number of allowed floors
+// inside the interval, where rank[f] counts the allowed floors 1..f.
+void travel_solve_state(int e,
+                        int lb,
+                        int ub,
+                        int k,
+                        const tDenseConfig& cfg,
+                        const std::vector<std::vector<int>>& D,
+                        const std::vector<int>& rank,
+                        tSided<int>& V,
+                        tSided<int>& A,
+                        tSided<long long>& S,
+                        std::vector<int>& ties,
+                        std::vector<long long>& bound)
+{
+  const tState s = {e, lb, ub, k == 0 ? lb : ub};
+  const long long w = ub - lb;
 
-    const bool looks_ok = check_policy(F, e, V, A, max_drops, mean_drops, &drops[e], &histo);
+  if (s.isterminal()) {
+    V.at(k, e, lb, ub) = 0;
+    S.at(k, e, lb, ub) = 0;
+    A.at(k, e, lb, ub) = lb;
+    return;
+  }
 
-    if (!looks_ok) {
-      std::cout << "DP solution is inconsistent (e = " << e << ")" << std::endl;
-      return 1;
+  if (e == 1) {
+    int a = tState::next_allowed(lb + 1);
+    for (int b = tState::next_allowed(a + 1); b < ub && tState({0, lb, b}).isterminal(); b = tState::next_allowed(b + 1)) {
+      if (cfg.minimize_mean ? w * s.cost(b, lb) + S.at(0, e, b, ub) <= w * s.cost(a, lb) + S.at(0, e, a, ub)
+                            : s.cost(b, lb) + V.at(0, e, b, ub) <= s.cost(a, lb) + V.at(0, e, a, ub))
+        a = b;
     }
+    const int c = s.cost(a, lb);
+    V.at(k, e, lb, ub) = c + V.at(0, e, a, ub);
+    S.at(k, e, lb, ub) = w * c + S.at(0, e, a, ub);
+    A.at(k, e, lb, ub) = a;
+    return;
+  }
 
-    std::cout << "--- floors F = " << F << ", eggs E = " << e << " ---" << std::endl;
-    std::cout << "min max drops = " << max_drops << " (optimal worst case)" << std::endl;
-    std::cout << "mean drops    = " << mean_drops << " (uniform limit floor)" << std::endl;
-    std::cout << "drops histg.  = " << histogram_to_string(histo, 0, max_drops) << std::endl;
+  auto exact = [&](int a) -> long long {
+    const int c = s.cost(a, lb);
+    if (cfg.minimize_mean)
+      return w * c + S.at(1, e - 1, lb, a) + S.at(0, e, a, ub);
+    return c + std::max(V.at(1, e - 1, lb, a), V.at(0, e, a, ub));
+  };
 
-    print_all_admissible({e, 0, F + 1}, V, &A);
+  bound.resize(w);
+  int guess = tState::next_allowed(lb + 1);
+  for (int a = guess; a < ub; a = tState::next_allowed(a + 1)) {
+    const long long c = s.cost(a, lb);
+    const int wb = rank[a - 1] - rank[lb] + 1;  // effective widths of the break and survive branches
+    const int ws = rank[ub - 1] - rank[a] + 1;
+    if (cfg.minimize_mean)
+      bound[a - lb] = w * c + cfg.min_cost * (min_path_length((wb + tState::tolerance) / (tState::tolerance + 1)) +
+                                              min_path_length((ws + tState::tolerance) / (tState::tolerance + 1)));
+    else
+      bound[a - lb] = c + static_cast<long long>(cfg.min_cost) * std::max(D[e - 1][wb], D[e][ws]);
+    if (bound[a - lb] < bound[guess - lb])
+      guess = a;
   }
 
-  std::cout << "--- min max drops, E = 1.." << E << " ---" << std::endl;
-  for (int f = 1; f <= F; f++) {
-    std::cout << "floors " << std::setw(3) << f << ": ";
-    for (int e = 1; e <= E; e++) {
-      auto itr = V.find({e, 0, f + 1});
-      std::cout << std::setw(3) << itr->second << " ";
+  long long best = exact(guess);
+  ties.clear();
+  for (int a = tState::next_allowed(lb + 1); a < ub; a = tState::next_allowed(a + 1)) {
+    if (bound[a - lb] > best)
+      continue;  // dominated
+    const long long value = exact(a);
+    if (value < best) {
+      best = value;
+      ties.clear();
     }
-    std::cout << std::endl;
+    if (value == best)
+      ties.push_back(a);
   }
 
-  // this table may not be monotonic in general (along F) unless --tiebreak is specified!
-  std::cout << "--- average drops, E = 1.." << E << " ---" << std::endl;
-  for (int f = 1; f <= F; f++) {
-    std::cout << "floors " << std::setw(3) << f << ": ";
-    for (int e = 1; e <= E; e++) {
-      check_policy(f, e, V, A, max_drops, mean_drops);
-      std::cout << std::setw(8) << mean_drops << " ";
+  int action = ties[ties.size() >> 1];
+  if (cfg.use_tiebreak && ties.size() > 1) {
+    // secondary objective among the ties: summed cost for minimax, worst case for mean
+    std::vector<long long> ties_totals;
+    for (int a : ties) {
+      if (cfg.minimize_mean)
+        ties_totals.push_back(s.cost(a, lb) + std::max(V.at(1, e - 1, lb, a), V.at(0, e, a, ub)));
+      else
+        ties_totals.push_back(w * s.cost(a, lb) + S.at(1, e - 1, lb, a) + S.at(0, e, a, ub));
     }
-    std::cout << std::endl;
+    action = ties[argmin_which<long long>(ties_totals, cfg.pick_left, cfg.pick_right)];
+  } else {
+    if (cfg.pick_left)
+      action = ties[0];
+    else if (cfg.pick_right)
+      action = ties[ties.size() - 1];
   }
 
-  std::cout << "--- drop histograms E = 1.." << E << " (F = " << F << ") ---" << std::endl;
-  for (int f = 1; f <= F; f++) {
-    std::cout << "floor  " << std::setw(3) << f << ": ";
-    for (int e = 1; e <= E; e++)
-      std::cout << std::setw(3) << drops[e][f] << " ";
-    std::cout << std::endl;
-  }
+  const int c = s.cost(action, lb);
+  V.at(k, e, lb, ub) = c + std::max(V.at(1, e - 1, lb, action), V.at(0, e, action, ub));
+  S.at(k, e, lb, ub) = w * c + S.at(1, e - 1, lb, action) + S.at(0, e, action, ub);
+  A.at(k, e, lb, ub) = action;
+}
 
-  std::cout << "--- optimal E = " << E << " executions for all limit levels L ---" << std::endl;
-  for (int x = 0; x <= F; x++) {
-    std::vector<int> aseq;
-    int xsteps = run_policy_once(F, E, x, A, &aseq);
-    std::cout << "L = " << std::setw(3) << x << ": ";
-    for (int y : aseq)
-      std::cout << y << " ";
-    std::cout << "(" << xsteps << " steps)" << std::endl;
+// Sweep the travel cost model: same (e, width) layering as dense_scan, both rig sides per state
+void travel_scan(int F,
+                 int E,
+                 const tDenseConfig& cfg,
+                 tSided<int>& V,
+                 tSided<int>& A,
+                 tSided<long long>& S,
+                 int verbosity = 0)
+{
+  std::vector<std::vector<int>> D;
+  unit_minimax_table(F, E, D);
+
+  std::vector<int> rank(F + 2, 0);
+  for (int f = 1; f <= F + 1; f++)
+    rank[f] = rank[f - 1] + (tState::next_allowed(f) == f && f <= F ? 1 : 0);
+
+  V.resize(F, E, 0);
+  A.resize(F, E, 0);
+  S.resize(F, E, 0);
+
+  for (int e = 1; e <= E; e++) {
+    for (int f = 0; f <= F; f++) {
+      A.at(0, e, f, f + 1) = f;
+      A.at(1, e, f, f + 1) = f;
+    }
+    for (int w = 2; w <= F + 1; w++) {
+      parallel_for(0, F + 2 - w, cfg.nthreads, [&](int lb_begin, int lb_end) {
+        std::vector<int> ties;
+        std::vector<long long> bound;
+        for (int lb = lb_begin; lb < lb_end; lb++) {
+          travel_solve_state(e, lb, lb + w, 0, cfg, D, rank, V, A, S, ties, bound);
+          travel_solve_state(e, lb, lb + w, 1, cfg, D, rank, V, A, S, ties, bound);
+        }
+      }, 64);
+    }
+    if (verbosity > 0)
+      std::cout << "level e = " << e << " swept (2 x " << V.side[0].per_level << " states)" << std::endl;
   }
+}
+
+// Noisy drops: an egg may break at or below f*, or survive above it
+struct tNoise {
+  double false_break;    // P(break | floor <= f*)
+  double false_survive;  // P(survive | floor > f*)
+};
+
+// Expected drops for noisy outcomes over the interval belief (e, lb, ub).
+// The policy trusts each outcome and updates lb or ub as usual. Every limit floor inside [lb, ub) agrees
+// with all outcomes observed so far, so they have equal likelihood and the belief restricted to the
+// interval stays uniform; the statistic ignores the mass left outside after a wrong outcome.
+// Drops follow the deterministic admissibility (a single egg only drops at the next allowed floor),
+// so every execution ends localized, but possibly at the wrong floor.
+void noisy_scan(int F,
+                int E,
+                const tNoise& noise,
+                const tDenseConfig& cfg,
+                tDense<double>& V,
+                tDense<int>& A)
+{
+  V.resize(F, E, 0.0);
+  A.resize(F, E, 0);
+
+  for (int e = 1; e <= E; e++) {
+    for (int f = 0; f <= F; f++)
+      A.at(e, f, f + 1) = f;
+    for (int w = 2; w <= F + 1; w++) {
+      parallel_for(0, F + 2 - w, cfg.nthreads, [&](int lb_begin, int lb_end) {
+        for (int lb = lb_begin; lb < lb_end; lb++) {
+          const int ub = lb + w;
+          const tState s = {e, lb, ub};
+          if (s.isterminal()) {
+            V.at(e, lb, ub) = 0.0;
+            A.at(e, lb, ub) = lb;
+            continue;
+          }
+          auto value_at = [&](int a) {
+            const double p_break = ((a - lb) * (1.0 - noise.false_survive) + (ub - a) * noise.false_break) / w;
+            const double v_break = (e == 1 ? 0.0 : V.at(e - 1, lb, a));
+            return 1.0 + p_break * v_break + (1.0 - p_break) * V.at(e, a, ub);
+          };
+          int action = tState::next_allowed(lb + 1);
+          double best = value_at(action);
+          if (e > 1) {
+            for (int a = tState::next_allowed(action + 1); a < ub; a = tState::next_allowed(a + 1)) {
+              const double value = value_at(a);
+              if (value < best || (cfg.pick_right && value == best)) {
+                best = value;
+                action = a;
+              }
+            }
+          }
+          V.at(e, lb, ub) = best;
+          A.at(e, lb, ub) = action;
+        }
+      });
+    }
+  }
+}
+
+struct tMonteCarlo {
+  long long trials;
+  long long sum_drops;
+  long long sum_drops_squared;
+  long long localized;   // executions that ended at the true limit floor
+  int max_drops;
+  std::unordered_map<int, int> H;
+};
+
+// Apply the outcomes of one drop per lane; r holds a 31-bit random number per lane, compared with the
+// fixed-point noise thresholds (probability times 2^31). The masks are sign shifts of differences (all
+// ones or zero), so the loop has no branches; n is a multiple of 8 and the blocks of 8 lanes vectorize.
+void noisy_outcomes(int n,
+                    const int* __restrict action,
+                    const int* __restrict limit,
+                    const int* __restrict r,
+                    int false_break,
+                    int false_survive,
+                    int* __restrict eggs,
+                    int* __restrict lb,
+                    int* __restrict ub)
+{
+  for (int b = 0; b < n; b += 8) {
+    for (int i = b; i < b + 8; i++) {
+      const int a = action[i];
+      const int above = (limit[i] - a) >> 31;
+      const int breaks = (~((r[i] - false_survive) >> 31) & above) | (((r[i] - false_break) >> 31) & ~above);
+      eggs[i] += breaks;
+      ub[i] = (a & breaks) | (ub[i] & ~breaks);
+      lb[i] = (lb[i] & breaks) | (a & ~breaks);
+    }
+  }
+}
+
+// Monte Carlo evaluation of policy A under noisy outcomes, with the limit floor uniform on 0..F.
+// Trials are run in batches; a batch advances all its live executions in lockstep one drop at a time
+// (structure of arrays). After every drop the finished executions are compacted out, so the action
+// gather, the random draws and the outcome update (noisy_outcomes) only touch live lanes. Batches are
+// spread over threads, each with its own random stream, so the result does not depend on the number
+// of threads.
+void monte_carlo_policy(int F,
+                        int E,
+                        const tDense<int>& A,
+                        const tNoise& noise,
+                        long long trials,
+                        unsigned int seed,
+                        int nthreads,
+                        tMonteCarlo& result)
+{
+  const int batch = 1024;
+  const int nbatches = static_cast<int>((trials + batch - 1) / batch);
+  const int false_break = static_cast<int>(noise.false_break * 2147483648.0);
+  const int false_survive = static_cast<int>(noise.false_survive * 2147483648.0);
+  std::mutex merge;
+  result = {0, 0, 0, 0, 0, {}};
+
+  parallel_for(0, nbatches, nthreads, [&](int b_begin, int b_end) {
+    tMonteCarlo local = {0, 0, 0, 0, 0, {}};
+    std::vector<long long> histogram;
+    std::vector<int> eggs(batch), lb(batch), ub(batch), limit(batch), action(batch);
+    std::vector<int> r(batch);
+    for (int b = b_begin; b < b_end; b++) {
+      std::mt19937 rng(static_cast<uint32_t>(seed + 0x9e3779b97f4a7c15ULL * (b + 1)));
+      std::uniform_int_distribution<int> pick_limit(0, F);
+      const int n = static_cast<int>(std::min<long long>(batch, trials - static_cast<long long>(b) * batch));
+      for (int i = 0; i < n; i++) {
+        eggs[i] = E;
+        lb[i] = 0;
+        ub[i] = F + 1;
+        limit[i] = pick_limit(rng);
+      }
+      int live = n;
+      for (int steps = 1; live > 0; steps++) {
+        for (int i = 0; i < live; i++)
+          action[i] = A.at(eggs[i], lb[i], ub[i]);
+        for (int i = 0; i < live; i++)
+          r[i] = static_cast<int>(rng() >> 1);
+        // the lanes past live (up to the next multiple of 8) are updated too, and are discarded below
+        noisy_outcomes((live + 7) & ~7, action.data(), limit.data(), r.data(), false_break, false_survive,
+                       eggs.data(), lb.data(), ub.data());
+        int kept = 0;
+        for (int i = 0; i < live; i++) {
+          const tState s = {eggs[i], lb[i], ub[i]};
+          if (s.isterminal() || s.isfailed()) {
+            local.sum_drops += steps;
+            local.sum_drops_squared += static_cast<long long>(steps) * steps;
+            local.localized += (s.isterminal() && lb[i] <= limit[i] && limit[i] < ub[i]) ? 1 : 0;
+            local.max_drops = std::max(local.max_drops, steps);
+            if (static_cast<int>(histogram.size()) <= steps)
+              histogram.resize(steps + 1, 0);
+            histogram[steps]++;
+          } else {
+            eggs[kept] = eggs[i];
+            lb[kept] = lb[i];
+            ub[kept] = ub[i];
+            limit[kept] = limit[i];
+            kept++;
+          }
+        }
+        live = kept;
+      }
+      local.trials += n;
+    }
+    std::lock_guard<std::mutex> lock(merge);
+    result.trials += local.trials;
+    result.sum_drops += local.sum_drops;
+    result.sum_drops_squared += local.sum_drops_squared;
+    result.localized += local.localized;
+    result.max_drops = std::max(result.max_drops, local.max_drops);
+    for (int k = 0; k < static_cast<int>(histogram.size()); k++) {
+      if (histogram[k] > 0)
+        result.H[k] += static_cast<int>(histogram[k]);
+    }
+  }, 1);
+}
+
+// Parallel droppers: each round makes j <= min(k, e) simultaneous drops at distinct floors, which split
+// [lb, ub) into j + 1 parts. If f* lies in the i-th part from below, the j - i drops above it break.
+// The objective is the minimax number of rounds. This is translation invariant, and the optimal
+// k-subsets have a nested structure: with r rounds left and e eggs, the part below which b eggs break
+// can be as wide as N[r - 1][e - b], the widest interval resolvable in r - 1 rounds with e - b eggs. So
+//   N[r][e] = sum_{b = 0..min(k, e)} N[r - 1][e - b],  N[0][e] = N[r][0] = 1,
+// and a round is found by filling the parts up to these capacities; no subset search is needed.
+void rounds_capacity(int F, int E, int k, std::vector<std::vector<long long>>& N)
+{
+  N.assign(1, std::vector<long long>(E + 1, 1));
+  while (N.back()[1] < F + 1) {
+    const std::vector<long long>& prev = N.back();
+    std::vector<long long> next(E + 1, 1);
+    for (int e = 1; e <= E; e++) {
+      next[e] = 0;
+      for (int b = 0; b <= std::min(k, e); b++)
+        next[e] = std::min<long long>(F + 1, next[e] + prev[e - b]);
+    }
+    N.push_back(next);
+  }
+}
+
+// Minimax number of rounds for an interval of width w with e eggs
+int rounds_needed(const std::vector<std::vector<long long>>& N, int e, long long w)
+{
+  int lo = 0;
+  int hi = static_cast<int>(N.size()) - 1;
+  while (lo < hi) {
+    const int mid = (lo + hi) >> 1;
+    if (N[mid][e] >= w)
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  return lo;
+}
+
+// The drop floors of one minimax optimal round at state s: parts are filled to capacity from the bottom
+// (most breaks) upwards, keeping at least one floor for each part still to come.
+void rounds_action(const std::vector<std::vector<long long>>& N, int k, const tState& s, std::vector<int>& floors)
+{
+  floors.clear();
+  const long long w = s.ub - s.lb;
+  const int r = rounds_needed(N, s.eggs, w);
+  const int j = static_cast<int>(std::min<long long>(std::min(k, s.eggs), w - 1));
+  long long remaining = w;
+  int floor = s.lb;
+  for (int i = 0; i < j; i++) {
+    const long long part = std::min(N[r - 1][s.eggs - (j - i)], remaining - (j - i));
+    floor += static_cast<int>(part);
+    remaining -= part;
+    floors.push_back(floor);
+  }
+}
+
+// Run the round policy for limit floor L; returns the number of rounds, with the total drops and broken eggs
+int run_rounds_once(int F,
+                    int E,
+                    int L,
+                    int k,
+                    const std::vector<std::vector<long long>>& N,
+                    int& drops,
+                    int& broken,
+                    std::vector<std::vector<int>>* rseq = nullptr)
+{
+  if (rseq != nullptr) rseq->clear();
+  tState s = {E, 0, F + 1};
+  std::vector<int> floors;
+  int rounds = 0;
+  drops = 0;
+  broken = 0;
+  while (!s.isterminal()) {
+    rounds_action(N, k, s, floors);
+    const tState before = s;
+    for (int a : floors)
+      s.observe(a, a > L);  // all drops of the round are committed before any outcome is seen
+    if (s.eggs < 0)
+      return -1;
+    drops += static_cast<int>(floors.size());
+    broken += before.eggs - s.eggs;
+    rounds++;
+    if (rseq != nullptr) rseq->push_back(floors);
+  }
+  return rounds;
+}
+
+// Cumulative damage: every survived drop adds a damage level to the egg (up to cap), and an egg at level d
+// breaks from floor a iff a > f* - step * d. Such a drop tests t = a + step * d, so a damaged egg can 
+// only test t >= 1 + step * d. Eggs with equal damage are interchangeable, so the egg basket is kept
+// as counts per damage level (a multiset) rather than as a tuple of labeled eggs.
+struct tDamage {
+  int step;  // floors of threshold lost per damage level
+  int cap;   // highest damage level
+  std::unordered_map<uint64_t, std::pair<int, int>> memo;  // value, action (level << 16 | floor)
+};
+
+// Pack the basket (4 bits per level, at most 8 levels) with lb and ub (16 bits each)
+uint64_t damage_key(const std::vector<int>& count, int lb, int ub)
+{
+  uint64_t key = 0;
+  for (size_t d = 0; d < count.size(); d++)
+    key |= static_cast<uint64_t>(count[d]) << (4 * d);
+  return (key << 32) | (static_cast<uint64_t>(lb) << 16) | static_cast<uint64_t>(ub);
+}
+
+// Minimax drops for basket count over [lb, ub), memoized over the canonical (multiset) states.
+// For a fixed damage level the break branch is nondecreasing and the survive branch nonincreasing in
+// the tested floor t, so only the two candidates around their crossover need to be evaluated.
+int damage_value(tDamage& D, const std::vector<int>& count, int lb, int ub)
+{
+  if (ub == lb + 1)
+    return 0;
+  const uint64_t key = damage_key(count, lb, ub);
+  const auto search = D.memo.find(key);
+  if (search != D.memo.end())
+    return search->second.first;
+
+  int best = INT_MAX;
+  int action = 0;
+  std::vector<int> broke(count);
+  std::vector<int> survived(count);
+  for (int d = 0; d <= D.cap; d++) {
+    if (count[d] == 0)
+      continue;
+    broke = count;
+    broke[d]--;
+    survived = count;
+    survived[d]--;
+    survived[std::min(d + 1, D.cap)]++;
+    auto branch_break = [&](int t) { return damage_value(D, broke, lb, t); };
+    auto branch_survive = [&](int t) { return damage_value(D, survived, t, ub); };
+    int lo = std::max(lb + 1, 1 + D.step * d);
+    int hi = ub - 1;
+    if (lo > hi)
+      continue;
+    while (lo < hi) {
+      const int mid = (lo + hi) >> 1;
+      if (branch_break(mid) >= branch_survive(mid))
+        hi = mid;
+      else
+        lo = mid + 1;
+    }
+    for (int t = std::max(lo - 1, std::max(lb + 1, 1 + D.step * d)); t <= lo; t++) {
+      const int vb = branch_break(t);
+      const int vs = branch_survive(t);
+      if (vb == INT_MAX || vs == INT_MAX)
+        continue;
+      if (1 + std::max(vb, vs) < best) {
+        best = 1 + std::max(vb, vs);
+        action = (d << 16) | (t - D.step * d);
+      }
+    }
+  }
+  D.memo[key] = {best, action};
+  return best;
+}
+
+// Run the damage policy for limit floor L; returns the number of drops (-1 if it fails)
+int run_damage_once(int F, int E, int L, tDamage& D, std::vector<int>* aseq = nullptr)
+{
+  if (aseq != nullptr) aseq->clear();
+  std::vector<int> count(D.cap + 1, 0);
+  count[0] = E;
+  int lb = 0;
+  int ub = F + 1;
+  int drops = 0;
+  while (ub > lb + 1) {
+    if (damage_value(D, count, lb, ub) == INT_MAX)
+      return -1;
+    const int action = D.memo[damage_key(count, lb, ub)].second;
+    const int d = action >> 16;
+    const int a = action & 0xffff;
+    const int t = a + D.step * d;
+    count[d]--;
+    if (L < t) {
+      ub = t;
+    } else {
+      lb = t;
+      count[std::min(d + 1, D.cap)]++;
+    }
+    drops++;
+    if (aseq != nullptr) aseq->push_back(a);
+  }
+  return drops;
+}
+
+// Number of labeled egg tuples represented by the memoized multiset states
+double damage_labeled_states(const tDamage& D)
+{
+  double total = 0.0;
+  for (const auto& m : D.memo) {
+    const uint64_t packed = m.first >> 32;
+    int n = 0;
+    double arrangements = 1.0;
+    for (int d = 0; d <= D.cap; d++) {
+      const int c = static_cast<int>((packed >> (4 * d)) & 0xf);
+      for (int i = 1; i <= c; i++)
+        arrangements = arrangements * (++n) / i;
+    }
+    total += arrangements;
+  }
+  return total;
+}
+
+// Three-outcome drops: a drop from floor a breaks if f* < a, cracks if a <= f* < a + c and survives if
+// f* >= a + c, so [lb, ub) splits into a break part, a crack band and a survive part. A break loses the
+// egg, a crack loses it unless cracked eggs are kept. The problem stays translation invariant, so the
+// tables are indexed by (e, w) and a decision is the offset x = a - lb. With lost cracked eggs a single
+// egg cannot resolve a crack band wider than one floor; such states keep the value INT_MAX / 4.
+struct tTernary {
+  int c;      // crack band width (0 gives the usual two outcomes)
+  bool keep;  // cracked eggs stay in use
+  std::vector<std::vector<int>> V;        // minimax drops
+  std::vector<std::vector<int>> X;        // minimax drop offset
+  std::vector<std::vector<long long>> T;  // minimum summed drops over the w limit floors
+  std::vector<std::vector<int>> Y;        // drop offset minimizing the summed drops
+};
+
+// Fill the ternary tables. For each (e, w) the candidate values for all offsets are first written into
+// a buffer by branch-free loops over contiguous rows (which the compiler vectorizes), and then reduced
+// by a single min_element. Offsets with a survive part (x <= w - 1 - c) see the full crack band;
+// above that the crack band is cut off by ub and there is no survive outcome.
+void ternary_tables(int F, int E, tTernary& t)
+{
+  const int INF = INT_MAX / 4;
+  const long long LINF = LLONG_MAX / 4;
+  t.V.assign(E + 1, std::vector<int>(F + 2, INF));
+  t.X.assign(E + 1, std::vector<int>(F + 2, 0));
+  t.T.assign(E + 1, std::vector<long long>(F + 2, LINF));
+  t.Y.assign(E + 1, std::vector<int>(F + 2, 0));
+  for (int e = 0; e <= E; e++) {
+    t.V[e][1] = 0;
+    t.T[e][1] = 0;
+  }
+  std::vector<int> vbuf(F + 2);
+  std::vector<long long> tbuf(F + 2);
+  for (int e = 1; e <= E; e++) {
+    const int ec = (t.keep ? e : e - 1);
+    const int* vb = t.V[e - 1].data();
+    const int* vc = t.V[ec].data();
+    const int* vs = t.V[e].data();
+    const long long* tb = t.T[e - 1].data();
+    const long long* tc = t.T[ec].data();
+    const long long* ts = t.T[e].data();
+    for (int w = 2; w <= F + 1; w++) {
+      const int split = std::max(0, w - 1 - t.c);  // last offset with a survive part
+      const int vband = (t.c > 0 ? vc[t.c] : 0);
+      const long long tband = (t.c > 0 ? tc[t.c] : 0);
+      for (int x = 1; x <= split; x++) {
+        vbuf[x] = std::max(vb[x], std::max(vband, vs[w - x - t.c]));
+        tbuf[x] = tb[x] + tband + ts[w - x - t.c];
+      }
+      for (int x = split + 1; x < w; x++) {
+        vbuf[x] = std::max(vb[x], vc[w - x]);
+        tbuf[x] = tb[x] + tc[w - x];
+      }
+      const int xv = static_cast<int>(std::min_element(vbuf.begin() + 1, vbuf.begin() + w) - vbuf.begin());
+      const int xt = static_cast<int>(std::min_element(tbuf.begin() + 1, tbuf.begin() + w) - tbuf.begin());
+      if (vbuf[xv] < INF) {
+        t.V[e][w] = 1 + vbuf[xv];
+        t.X[e][w] = xv;
+      }
+      if (tbuf[xt] < LINF) {
+        t.T[e][w] = w + tbuf[xt];
+        t.Y[e][w] = xt;
+      }
+    }
+  }
+}
+
+// Run the minimax (or the summed drops) ternary policy for limit floor L; returns the number of drops
+int run_ternary_once(int F, int E, int L, const tTernary& t, bool mean_policy, std::vector<int>* aseq = nullptr)
+{
+  if (aseq != nullptr) aseq->clear();
+  int e = E;
+  int lb = 0;
+  int ub = F + 1;
+  int drops = 0;
+  while (ub > lb + 1) {
+    const int a = lb + (mean_policy ? t.Y[e][ub - lb] : t.X[e][ub - lb]);
+    if (L < a) {
+      ub = a;
+      e--;
+    } else if (L < a + t.c) {
+      lb = a;
+      ub = std::min(ub, a + t.c);
+      if (!t.keep)
+        e--;
+    } else {
+      lb = a + t.c;
+    }
+    drops++;
+    if (aseq != nullptr) aseq->push_back(a);
+  }
+  return drops;
+}
+
+// Liar-tolerant search (Ulam's game with threshold questions): up to k drop outcomes may be wrong, and
+// eggs are not modelled (a lie does not tell whether the egg actually broke). A state lists the remaining
+// candidate limit floors in order, each with the number of outcomes it would declare wrong; candidates
+// with more than k lies are dropped. The lie vector (x_0, .., x_k), the number of candidates per lie
+// count, gives Berlekamp's volume bound but not the value (threshold questions depend on the order), so
+// the memo key is the lie sequence itself, canonicalized under mirroring.
+struct tLiarBounds {
+  int lo;     // the state cannot be settled in fewer drops
+  int hi;     // the state is settled within hi drops by dropping at split
+  int split;
+};
+
+struct tLiar {
+  int k;
+  std::unordered_map<std::string, tLiarBounds> memo;  // canonical lie sequence -> bounds
+};
+
+// Berlekamp volume of a candidate with j lies left and q questions to go: ball[j] = sum_{i <= j} C(q, i)
+void liar_ball(int q, int k, std::vector<double>& ball)
+{
+  ball.assign(k + 1, 0.0);
+  double binom = 1.0;  // C(q, i)
+  double partial = 0.0;
+  for (int i = 0; i <= k; i++) {
+    partial += binom;
+    ball[i] = partial;
+    binom = binom * (q - i) / (i + 1);
+  }
+}
+
+// Berlekamp's volume bound: q questions can only settle a state whose summed volume is at most 2^q
+int liar_volume_bound(const std::string& s, int k)
+{
+  if (s.size() <= 1)
+    return 0;
+  std::vector<double> x(k + 1, 0.0);
+  for (char c : s)
+    x[c] += 1.0;
+  std::vector<double> ball;
+  for (int q = 1;; q++) {
+    liar_ball(q, k, ball);
+    double volume = 0.0;
+    for (int j = 0; j <= k; j++)
+      volume += x[j] * ball[k - j];
+    if (volume <= std::ldexp(1.0, q))
+      return q;
+  }
+}
+
+// Lie sequence after a drop splitting s before position t (break: candidates from t on lie once more)
+void liar_answer(const std::string& s, int t, bool broke, int k, std::string& out)
+{
+  out.clear();
+  for (int i = 0; i < static_cast<int>(s.size()); i++) {
+    const char c = s[i] + ((i < t) != broke ? 1 : 0);
+    if (c <= k)
+      out.push_back(c);
+  }
+}
+
+// Can lie sequence s be settled within q drops? Known bounds lo <= value <= hi are memoized, so a state is
+// only searched for q strictly between them. Answer volumes for all splits follow from prefix sums; a
+// split whose larger answer volume exceeds 2^(q - 1) cannot work, and the others are tried in order of
+// that volume, so a split meeting the bound usually comes first.
+bool liar_feasible(tLiar& D, const std::string& s, int q)
+{
+  const int n = static_cast<int>(s.size());
+  if (n <= 1)
+    return true;
+  std::string rev(s.rbegin(), s.rend());
+  const std::string key = (rev < s ? rev : s);
+  auto it = D.memo.find(key);
+  if (it == D.memo.end())
+    it = D.memo.emplace(key, tLiarBounds{liar_volume_bound(key, D.k), INT_MAX, 0}).first;
+  if (q >= it->second.hi)
+    return true;
+  if (q < it->second.lo)
+    return false;
+
+  std::vector<double> ball;
+  liar_ball(q - 1, D.k, ball);
+  std::vector<double> same(n + 1, 0.0);  // prefix volumes without an extra lie
+  std::vector<double> more(n + 1, 0.0);  // prefix volumes with an extra lie
+  for (int i = 0; i < n; i++) {
+    same[i + 1] = same[i] + ball[D.k - key[i]];
+    more[i + 1] = more[i] + (key[i] < D.k ? ball[D.k - key[i] - 1] : 0.0);
+  }
+  const double room = std::ldexp(1.0, q - 1);
+  std::vector<std::pair<double, int>> order;
+  for (int t = 1; t < n; t++) {
+    const double volume = std::max(same[t] + more[n] - more[t], more[t] + same[n] - same[t]);
+    if (volume <= room)
+      order.push_back({volume, t});
+  }
+  std::sort(order.begin(), order.end());
+
+  std::string broke, survived;
+  for (const auto& o : order) {
+    liar_answer(key, o.second, true, D.k, broke);
+    liar_answer(key, o.second, false, D.k, survived);
+    if (liar_feasible(D, broke, q - 1) && liar_feasible(D, survived, q - 1)) {
+      tLiarBounds& b = D.memo[key];  // the recursion may have rehashed the memo
+      b.hi = q;
+      b.split = o.second;
+      return true;
+    }
+  }
+  D.memo[key].lo = q + 1;
+  return false;
+}
+
+// Minimax drops for lie sequence s: raise q from the volume bound until s can be settled
+int liar_value(tLiar& D, const std::string& s)
+{
+  int q = liar_volume_bound(s, D.k);
+  while (!liar_feasible(D, s, q))
+    q++;
+  return q;
+}
+
+// Split chosen for lie sequence s (in the orientation of s)
+int liar_split(tLiar& D, const std::string& s)
+{
+  std::string rev(s.rbegin(), s.rend());
+  if (rev < s)
+    return static_cast<int>(s.size()) - D.memo[rev].split;
+  return D.memo[s].split;
+}
+
+// Follow the liar policy for limit floor L against every pattern of at most k wrong outcomes; counts the
+// patterns, the worst drops per number of lies told and the patterns that end on a wrong floor.
+void run_liar_patterns(tLiar& D, int L, const std::string& s, const std::vector<int>& floors, int lies, int drops,
+                       long long& patterns, long long& failures, std::vector<int>& max_drops)
+{
+  if (s.size() <= 1) {
+    patterns++;
+    if (floors.size() != 1 || floors[0] != L)
+      failures++;
+    max_drops[lies] = std::max(max_drops[lies], drops);
+    return;
+  }
+  const int t = liar_split(D, s);
+  const int a = floors[t];
+  for (int lie = 0; lie <= (lies < D.k ? 1 : 0); lie++) {
+    const bool broke = ((L < a) != (lie == 1));
+    std::string next;
+    std::vector<int> next_floors;
+    for (int i = 0; i < static_cast<int>(s.size()); i++)
+      if (s[i] + ((i < t) != broke ? 1 : 0) <= D.k)
+        next_floors.push_back(floors[i]);
+    liar_answer(s, t, broke, D.k, next);
+    run_liar_patterns(D, L, next, next_floors, lies + lie, drops + 1, patterns, failures, max_drops);
+  }
+}
+
+// Unbounded buildings: f* >= 0 has no known upper bound. A ramp drops with all E eggs at a_1 < a_2 < ..
+// until the first break at a_i, which leaves the w_i = a_i - a_(i-1) candidates [a_(i-1), a_i) (a_0 = 0)
+// to the bounded minimax policy with E - 1 eggs. The exponential ramp doubles the gaps, the reach ramp
+// uses w_i = R(E - 1, i - 1) + 1, so that a break at step i is settled within i - 1 further drops. All
+// counts follow from the reach R(e, d) = sum_{j=1..e} C(d, j) (widest interval is R(e, d) + 1), so
+// worst and mean drops are evaluated per bracket in closed form instead of per floor.
+const long long REACH_CAP = 1LL << 62;
+
+// R(e, d), saturated at REACH_CAP
+long long reach_floors(int e, long long d)
+{
+  __int128 term = 1;  // C(d, j)
+  __int128 total = 0;
+  for (int j = 1; j <= e && j <= d; j++) {
+    term = term * (d - j + 1) / j;
+    total += term;
+    if (total >= REACH_CAP)
+      return REACH_CAP;
+  }
+  return static_cast<long long>(total);
+}
+
+// Minimax drops for w candidates with e eggs (LLONG_MAX if e = 0 cannot settle them)
+long long bounded_drops(int e, long long w);
+
+// Minimax drops for w candidates when the limit floor need only be pinned to k + 1 floors: drops settle
+// at most (k + 1) (reach + 1) candidates, i.e. the exact search over ceil(w / (k + 1)) candidates
+long long tolerant_drops(int e, long long w, int k)
+{
+  return bounded_drops(e, (w + k) / (k + 1));
+}
+
+long long bounded_drops(int e, long long w)
+{
+  if (w <= 1)
+    return 0;
+  if (e == 0)
+    return LLONG_MAX;
+  long long lo = 1;
+  long long hi = w - 1;
+  while (lo < hi) {
+    const long long mid = lo + (hi - lo) / 2;
+    if (reach_floors(e, mid) + 1 >= w)
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  return lo;
+}
+
+// Summed drops of the bounded minimax policy over all w candidates with e eggs. The policy drops at offset
+// x = min(R(e - 1, d - 1) + 1, w - 1), where d = bounded_drops(e, w): the break part is then as wide as
+// d - 1 drops allow with e - 1 eggs, and the survive part still fits into d - 1 drops with e eggs.
+long long bounded_sum(int e, long long w, std::map<std::pair<int, long long>, long long>& memo)
+{
+  if (w <= 1)
+    return 0;
+  if (e == 1)
+    return (w - 1) * w / 2 + (w - 1);
+  auto it = memo.find({e, w});
+  if (it != memo.end())
+    return it->second;
+  long long sum = 0;
+  long long acc = 0;
+  for (long long v = w; v > 1; acc++) {
+    const long long x = std::min(reach_floors(e - 1, bounded_drops(e, v) - 1) + 1, v - 1);
+    sum += x * (acc + 1) + bounded_sum(e - 1, x, memo);
+    v -= x;
+    if (v == 1)
+      sum += acc + 1;
+  }
+  memo[{e, w}] = sum;
+  return sum;
+}
+
+// Summed and max drops of the bounded minimax policy over the first m of w candidates with e eggs
+void bounded_prefix(int e, long long w, long long m, std::map<std::pair<int, long long>, long long>& memo,
+                    long long& sum, long long& max_drops)
+{
+  sum = 0;
+  max_drops = 0;
+  long long acc = 0;
+  while (m > 0) {
+    if (w <= 1) {
+      sum += acc;
+      max_drops = std::max(max_drops, acc);
+      return;
+    }
+    if (e == 1) {
+      const long long j = std::min(m, w - 1);  // candidates settled by j drops
+      sum += m * acc + j * (j + 1) / 2 + (m - j) * (w - 1);
+      max_drops = std::max(max_drops, acc + j);
+      return;
+    }
+    const long long x = std::min(reach_floors(e - 1, bounded_drops(e, w) - 1) + 1, w - 1);
+    if (m <= x) {
+      e--;
+      w = x;
+    } else {
+      sum += x * (acc + 1) + bounded_sum(e - 1, x, memo);
+      max_drops = std::max(max_drops, acc + 1 + bounded_drops(e - 1, x));
+      m -= x;
+      w -= x;
+    }
+    acc++;
+  }
+}
+
+// Report worst and mean drops of the exponential and reach ramps as functions of f* up to N, next to the
+// bounded minimax policy that knows F = f*
+int print_unbounded_report(long long N, int E)
+{
+  std::map<std::pair<int, long long>, long long> memo;
+  std::vector<long long> checkpoints;
+  for (long long p = 1; p <= N; p *= 10) {
+    for (long long c : {p, 2 * p, 5 * p})
+      if (c <= N)
+        checkpoints.push_back(c);
+  }
+  if (checkpoints.back() != N)
+    checkpoints.push_back(N);
+
+  if (E == 1) {
+    std::cout << "--- one egg: both ramps climb floor by floor (drops at f*, worst and mean over 0..f*) ---" << std::endl;
+    for (long long f : checkpoints)
+      std::cout << "f* = " << std::setw(10) << f << ": drops " << f + 1 << ", worst " << f + 1 << ", mean "
+                << (f + 2) / 2.0 << " (known F: worst " << f << ", mean "
+                << static_cast<double>(bounded_sum(1, f + 1, memo)) / (f + 1) << ")" << std::endl;
+    return 0;
+  }
+
+  for (int ramp = 0; ramp < 2; ramp++) {
+    std::cout << "--- " << (ramp == 0 ? "exponential" : "reach") << " ramp, E = " << E
+              << ": drops at f*, worst and mean over 0..f* (bounded policy knowing F = f*) ---" << std::endl;
+    long long a = 0;                // bottom of the current bracket
+    long long full_sum = 0;         // summed drops of the brackets below a
+    long long full_max = 0;         // max drops of the brackets below a
+    size_t next = 0;
+    for (long long i = 1; next < checkpoints.size(); i++) {
+      const long long w = (ramp == 0 ? (i <= 62 ? 1LL << (i - 1) : REACH_CAP) : reach_floors(E - 1, i - 1) + 1);
+      while (next < checkpoints.size() && checkpoints[next] < a + w) {
+        const long long f = checkpoints[next];
+        long long sum, max_drops, sum_before, max_before;
+        bounded_prefix(E - 1, w, f - a + 1, memo, sum, max_drops);
+        bounded_prefix(E - 1, w, f - a, memo, sum_before, max_before);
+        const long long drops = i + sum - sum_before;
+        const double mean = (full_sum + static_cast<double>(sum) + i * static_cast<double>(f - a + 1)) / (f + 1);
+        const long long known = bounded_drops(E, f + 1);
+        const double known_mean = static_cast<double>(bounded_sum(E, f + 1, memo)) / (f + 1);
+        std::cout << "f* = " << std::setw(10) << f << ": drops " << std::setw(6) << drops << ", worst "
+                  << std::setw(6) << std::max(full_max, i + max_drops) << ", mean " << std::setw(10) << mean
+                  << " (known F: worst " << known << ", mean " << known_mean << ")" << std::endl;
+        next++;
+      }
+      full_sum += i * w + bounded_sum(E - 1, w, memo);
+      full_max = std::max(full_max, i + bounded_drops(E - 1, w));
+      a += w;
+    }
+  }
+
+  return 0;
+}
+
+// Delayed feedback: every slot either commits a drop or idles, and the result of the drop committed in
+// slot t is only known before slot t + p + 1, so up to p drops are in flight. The state is (e, w) plus the
+// queue of the p last slots, stored relative to lb: 0 is an idle slot, 1..w-1 a drop at lb + x, and w a
+// drop that is known to survive (at or below lb). A drop known to break (at or above ub) is cleared to an
+// idle slot and its egg is written off at once. A drop needs an egg in hand, i.e. more eggs than busy
+// slots. The objective is the minimax number of slots until f* is known.
+struct tPipeline {
+  int F, E, p;
+  std::vector<long long> offset;  // offset[w]: first index of width w within one egg level
+  long long per_level;
+  std::vector<int> V;             // minimax slots
+  std::vector<int> A;             // slot action: 0 idles, x > 0 drops at lb + x
+
+  long long index(int e, int w, const int* q) const {
+    long long local = 0;
+    for (int i = 0; i < p; i++)
+      local = local * (w + 1) + q[i];
+    return e * per_level + offset[w] + local;
+  }
+};
+
+// Reveal the oldest of the p + 1 slots L (queue and new action) of state (e, w). Returns the number of
+// outcomes: 1 if the slot holds no information, else 2 (break first, then survive), with the successor
+// states in e_next[k], w_next[k] and q_next[k * p ..].
+int pipeline_reveal(int e, int w, const int* L, int p, int* e_next, int* w_next, int* q_next)
+{
+  const int y = L[0];
+  if (y == 0 || y == w) {
+    e_next[0] = e;
+    w_next[0] = w;
+    std::copy(L + 1, L + p + 1, q_next);
+    return 1;
+  }
+  e_next[0] = e - 1;
+  w_next[0] = y;
+  e_next[1] = e;
+  w_next[1] = w - y;
+  for (int i = 0; i < p; i++) {
+    const int z = L[i + 1];
+    if (z == 0 || z == w) {
+      q_next[i] = (z == 0 ? 0 : y);
+      q_next[p + i] = (z == 0 ? 0 : w - y);
+      continue;
+    }
+    if (z < y) {
+      q_next[i] = z;
+    } else {
+      q_next[i] = 0;
+      e_next[0]--;
+    }
+    q_next[p + i] = (z <= y ? w - y : z - y);
+  }
+  return 2;
+}
+
+// Best action and value of state (e, w, q) given the values of all successors in P.V
+std::pair<int, int> pipeline_evaluate(const tPipeline& P, int e, int w, const int* q)
+{
+  const int INF = INT_MAX / 4;
+  int busy = 0;
+  for (int i = 0; i < P.p; i++)
+    busy += (q[i] > 0 ? 1 : 0);
+  std::vector<int> L(P.p + 1);
+  std::copy(q, q + P.p, L.begin());
+  int e_next[2], w_next[2];
+  std::vector<int> q_next(2 * P.p + 1);
+  int best = INF;
+  int action = 0;
+  for (int x = (e > busy ? 1 : w); x <= w; x++) {
+    L[P.p] = (x == w ? 0 : x);  // x == w stands for the idle slot, tried last
+    const int n = pipeline_reveal(e, w, L.data(), P.p, e_next, w_next, q_next.data());
+    int worst = 0;
+    for (int k = 0; k < n && worst < INF; k++) {
+      if (w_next[k] > 1)
+        worst = std::max(worst, P.V[P.index(e_next[k], w_next[k], q_next.data() + k * P.p)]);
+    }
+    if (worst < INF && 1 + worst < best) {
+      best = 1 + worst;
+      action = L[P.p];
+    }
+  }
+  return {best, action};
+}
+
+// Fill P.V and P.A by value iteration. Breaks lower e and survives lower w, so the (e, w) blocks are
+// solved in order; only reveals without information stay within a block (idle slots make it cyclic),
+// and a block is swept (in parallel, from the previous sweep) until its values stop changing.
+int pipeline_solve(tPipeline& P, int nthreads)
+{
+  const int INF = INT_MAX / 4;
+  P.offset.assign(P.F + 2, 0);
+  long long total = 0;
+  for (int w = 1; w <= P.F + 1; w++) {
+    P.offset[w] = total;
+    long long size = 1;
+    for (int i = 0; i < P.p; i++)
+      size *= (w + 1);
+    total += size;
+  }
+  P.per_level = total;
+  P.V.assign((P.E + 1) * total, INF);
+  P.A.assign((P.E + 1) * total, 0);
+
+  int sweeps = 0;
+  for (int e = 0; e <= P.E; e++) {
+    for (int w = 2; w <= P.F + 1; w++) {
+      const long long begin = e * P.per_level + P.offset[w];
+      const int size = static_cast<int>((w < P.F + 1 ? P.offset[w + 1] : P.per_level) - P.offset[w]);
+      std::vector<int> next(size);
+      for (bool changed = true; changed;) {
+        sweeps++;
+        parallel_for(0, size, nthreads, [&](int b, int n) {
+          std::vector<int> q(P.p);
+          for (int local = b; local < n; local++) {
+            int rest = local;
+            for (int i = P.p - 1; i >= 0; i--) {
+              q[i] = rest % (w + 1);
+              rest /= (w + 1);
+            }
+            const std::pair<int, int> best = pipeline_evaluate(P, e, w, q.data());
+            next[local] = best.first;
+            P.A[begin + local] = best.second;
+          }
+        });
+        changed = !std::equal(next.begin(), next.end(), P.V.begin() + begin);
+        std::copy(next.begin(), next.end(), P.V.begin() + begin);
+      }
+    }
+  }
+  return sweeps;
+}
+
+// Follow the pipelined policy for limit floor L; returns the number of slots and counts the drops
+int run_pipeline_once(const tPipeline& P, int L, int& drops, std::vector<int>* aseq = nullptr)
+{
+  if (aseq != nullptr)
+    aseq->clear();
+  int e = P.E;
+  int w = P.F + 1;
+  int lb = 0;
+  std::vector<int> slots(P.p + 1, 0);  // queue followed by the new action
+  std::vector<int> q_next(2 * P.p + 1);
+  int e_next[2], w_next[2];
+  int steps = 0;
+  drops = 0;
+  while (w > 1) {
+    const int x = P.A[P.index(e, w, slots.data())];
+    slots[P.p] = x;
+    if (x > 0)
+      drops++;
+    if (aseq != nullptr)
+      aseq->push_back(x > 0 ? lb + x : -1);
+    const int y = slots[0];
+    const int n = pipeline_reveal(e, w, slots.data(), P.p, e_next, w_next, q_next.data());
+    const int k = (n == 2 && L >= lb + y ? 1 : 0);
+    if (k == 1)
+      lb += y;
+    e = e_next[k];
+    w = w_next[k];
+    std::copy(q_next.begin() + k * P.p, q_next.begin() + (k + 1) * P.p, slots.begin());
+    steps++;
+  }
+  return steps;
+}
+
+// Staged schedules: all drops of a stage are committed before any of their results is known, so they are
+// made at once and each needs an egg in hand. A stage with m drops splits [lb, ub) into m + 1 parts, and
+// f* in part i (counted from the bottom) leaves e - m + i eggs. Cap(r, e, D) is the widest interval that
+// r stages settle with e eggs and at most D drops on every path:
+//   Cap(0, e, D) = 1,  Cap(r, e, D) = max_{m <= min(e, D)} sum_{i = 0..m} Cap(r - 1, e - m + i, D - m).
+// One stage (r = 1) is the non-adaptive schedule; with r = D stages it is the adaptive optimum.
+struct tStages {
+  int F, E, R;
+  std::vector<long long> cap;  // Cap(r, e, D), saturated at F + 1
+
+  long long at(int r, int e, int D) const {
+    return cap[(static_cast<size_t>(r) * (E + 1) + e) * (F + 1) + D];
+  }
+};
+
+// Fill the capacities for r <= R stages, e <= E eggs and D <= F drops. For each (r, e, D) the number m
+// of drops in the first stage is searched upwards and stops once the interval of F + 1 floors fits.
+void stages_capacity(tStages& S)
+{
+  const long long W = S.F + 1;
+  S.cap.assign(static_cast<size_t>(S.R + 1) * (S.E + 1) * (S.F + 1), 1);
+  for (int r = 1; r <= S.R; r++) {
+    for (int e = 0; e <= S.E; e++) {
+      for (int D = 0; D <= S.F; D++) {
+        long long best = 1;
+        for (int m = 1; m <= std::min(e, D) && best < W; m++) {
+          long long sum = 0;
+          for (int i = 0; i <= m && sum < W; i++)
+            sum += S.at(r - 1, e - m + i, D - m);
+          best = std::max(best, std::min(sum, W));
+        }
+        S.cap[(static_cast<size_t>(r) * (S.E + 1) + e) * (S.F + 1) + D] = best;
+      }
+    }
+  }
+}
+
+// The floors of the first of r stages for [lb, ub) with e eggs and a budget of D drops: the fewest drops
+// that fit, every part non-empty and filled to capacity from the bottom (as the rounds of droppers)
+void stage_floors(const tStages& S, int r, int e, int D, int lb, int ub, std::vector<int>& floors)
+{
+  floors.clear();
+  const long long w = ub - lb;
+  for (int m = 1; m <= std::min(e, D) && m < w; m++) {
+    long long sum = 0;
+    for (int i = 0; i <= m; i++)
+      sum += S.at(r - 1, e - m + i, D - m);
+    if (sum < w)
+      continue;
+    std::vector<long long> size(m + 1, 1);
+    long long rest = w - (m + 1);
+    for (int i = 0; i <= m && rest > 0; i++) {
+      const long long more = std::min(rest, S.at(r - 1, e - m + i, D - m) - 1);
+      size[i] += more;
+      rest -= more;
+    }
+    long long a = lb;
+    for (int i = 0; i < m; i++) {
+      a += size[i];
+      floors.push_back(static_cast<int>(a));
+    }
+    return;
+  }
+}
+
+// Run the r-stage schedule with a budget of D drops for limit floor L; returns the number of drops
+int run_stages_once(const tStages& S, int r, int D, int L, std::vector<std::vector<int>>* sseq = nullptr)
+{
+  if (sseq != nullptr)
+    sseq->clear();
+  int e = S.E;
+  int lb = 0;
+  int ub = S.F + 1;
+  int drops = 0;
+  for (; r > 0 && ub > lb + 1; r--) {
+    std::vector<int> floors;
+    stage_floors(S, r, e, D - drops, lb, ub, floors);
+    for (int a : floors) {
+      if (L < a) {
+        ub = std::min(ub, a);
+        e--;
+      } else {
+        lb = a;
+      }
+    }
+    drops += static_cast<int>(floors.size());
+    if (sseq != nullptr)
+      sseq->push_back(floors);
+  }
+  return drops;
+}
+
+// Economic objective: every drop costs 1 and every broken egg costs egg_cost (so egg_cost is the price
+// ratio). Optionally an egg can be bought for buy_cost; buying is only worth it once the eggs run out, so
+// the empty egg level becomes V(0, w) = buy_cost + V(1, w). Costs do not depend on the floor, so the
+// tables are indexed by (e, w) as for the three-outcome drops.
+struct tEconomic {
+  int F, E;
+  double egg_cost;
+  double buy_cost;                       // < 0: no eggs can be bought
+  std::vector<std::vector<double>> V;    // minimax cost
+  std::vector<std::vector<int>> X;       // minimax drop offset
+  std::vector<std::vector<double>> T;    // minimum cost summed over the w limit floors
+  std::vector<std::vector<int>> Y;       // drop offset minimizing the summed cost
+};
+
+// Fill the tables. The minimax break branch 1 + egg_cost + V(e - 1, x) is nondecreasing and the survive
+// branch 1 + V(e, w - x) nonincreasing in x, so the minimax offset is found at their crossover by binary
+// search. The summed cost w + egg_cost x + T(e - 1, x) + T(e, w - x) has no such structure and is scanned.
+void economic_tables(tEconomic& C)
+{
+  const double INF = std::numeric_limits<double>::infinity();
+  C.V.assign(C.E + 1, std::vector<double>(C.F + 2, INF));
+  C.T.assign(C.E + 1, std::vector<double>(C.F + 2, INF));
+  C.X.assign(C.E + 1, std::vector<int>(C.F + 2, 0));
+  C.Y.assign(C.E + 1, std::vector<int>(C.F + 2, 0));
+  for (int e = 0; e <= C.E; e++)
+    C.V[e][1] = C.T[e][1] = 0.0;
+  for (int w = 2; w <= C.F + 1; w++) {
+    for (int e = 1; e <= C.E; e++) {
+      const std::vector<double>& vb = C.V[e - 1];
+      const std::vector<double>& vs = C.V[e];
+      auto branch_break = [&](int x) { return 1.0 + C.egg_cost + vb[x]; };
+      auto branch_survive = [&](int x) { return 1.0 + vs[w - x]; };
+      int lo = 1;
+      int hi = w - 1;
+      while (lo < hi) {
+        const int mid = (lo + hi) >> 1;
+        if (branch_break(mid) >= branch_survive(mid))
+          hi = mid;
+        else
+          lo = mid + 1;
+      }
+      int x = lo;
+      if (x > 1 && std::max(branch_break(x - 1), branch_survive(x - 1)) <= std::max(branch_break(x), branch_survive(x)))
+        x--;
+      C.V[e][w] = std::max(branch_break(x), branch_survive(x));
+      C.X[e][w] = x;
+
+      const std::vector<double>& tb = C.T[e - 1];
+      const std::vector<double>& ts = C.T[e];
+      double best = INF;
+      int best_x = 1;
+      for (int y = 1; y < w; y++) {
+        const double t = C.egg_cost * y + tb[y] + ts[w - y];
+        if (t < best) {
+          best = t;
+          best_x = y;
+        }
+      }
+      C.T[e][w] = w + best;
+      C.Y[e][w] = best_x;
+    }
+    if (C.buy_cost >= 0.0) {
+      C.V[0][w] = C.buy_cost + C.V[1][w];
+      C.T[0][w] = C.buy_cost * w + C.T[1][w];
+    }
+  }
+}
+
+// Run the minimax (or the summed cost) economic policy for limit floor L; returns the cost and counts
+// drops, broken and bought eggs
+double run_economic_once(const tEconomic& C, int L, bool mean_policy, int& drops, int& broken, int& bought)
+{
+  int e = C.E;
+  int lb = 0;
+  int ub = C.F + 1;
+  drops = broken = bought = 0;
+  while (ub > lb + 1) {
+    if (e == 0) {
+      e++;
+      bought++;
+    }
+    const int a = lb + (mean_policy ? C.Y[e][ub - lb] : C.X[e][ub - lb]);
+    if (L < a) {
+      ub = a;
+      e--;
+      broken++;
+    } else {
+      lb = a;
+    }
+    drops++;
+  }
+  return drops + C.egg_cost * broken + std::max(0.0, C.buy_cost) * bought;
+}
+
+// Two-dimensional thresholds: the egg survives a probe (x, y) (height x, angle y) iff x <= t_x and y <= t_y
+// for the unknown threshold (t_x, t_y) in [0, F] x [0, A]. A survive moves the lower corner up to the probe,
+// and a break removes the quadrant above it, so relative to the lower corner the candidates always form a
+// staircase: a partition, given by nonincreasing column heights. The value of a staircase does not depend
+// on where it sits, and mirroring the axes (the conjugate partition) gives the same game, so a staircase
+// whose mirror image also fits the box is stored under the smaller of the two ranks. Partitions in the
+// (F + 1) x (A + 1) box are ranked densely through their boundary path (F + 1 right and A + 1 down steps)
+// in the combinatorial number system. Eggs beyond the unlimited-egg depth do not matter: probes on the two
+// axes bisect each coordinate, so no state needs more than ceil(log2(F + 1)) + ceil(log2(A + 1)) drops,
+// and the egg levels above that are not stored.
+const int GRID_MAX_SIDE = 14;  // M = max(F, A) + 1 <= 14 keeps the stack arrays small
+const long long GRID_MAX_BYTES = 1LL << 31;  // bound on the tables and the enumerated states
+
+struct tGrid2D {
+  int F, A, E, M;
+  int levels;                    // egg levels stored, min(E, unlimited-egg depth)
+  std::vector<std::vector<long long>> binom;
+  long long per_level;           // C(F + A + 2, F + 1)
+  std::vector<int> V;            // minimax drops per (e, canonical rank)
+  std::vector<int> P;            // probe x * M + y (in the orientation of the canonical rank)
+
+  size_t index(int e, long long r) const { return static_cast<size_t>(std::min(e, levels)) * per_level + r; }
+
+  long long rank(const int* h) const {
+    long long r = 0;
+    int pos = 0;
+    int rights = 0;
+    int prev = A + 1;
+    for (int x = 0; x <= F; x++) {
+      pos += prev - h[x];
+      prev = h[x];
+      rights++;
+      r += binom[pos][rights];
+      pos++;
+    }
+    return r;
+  }
+};
+
+// Conjugate partition: conj[y] = number of columns higher than y
+void grid_conjugate(const int* h, int M, int* conj)
+{
+  int n = M;
+  for (int y = 0; y < M; y++) {
+    while (n > 0 && h[n - 1] <= y)
+      n--;
+    conj[y] = n;
+  }
+}
+
+// Whether the mirror image conj of a staircase in the box fits the box as well
+bool grid_conjugate_in_box(const tGrid2D& G, const int* h, const int* conj)
+{
+  return (h[0] <= G.F + 1 && conj[0] <= G.A + 1);
+}
+
+// Canonical rank of staircase h and whether it is the mirrored one
+long long grid_canonical(const tGrid2D& G, const int* h, bool& mirrored)
+{
+  int conj[GRID_MAX_SIDE];
+  grid_conjugate(h, G.M, conj);
+  const long long r = G.rank(h);
+  mirrored = false;
+  if (!grid_conjugate_in_box(G, h, conj))
+    return r;
+  const long long rc = G.rank(conj);
+  mirrored = (rc < r);
+  return mirrored ? rc : r;
+}
+
+// Children of staircase h for probe (px, py): the candidates at or above the probe (survive, shifted to the
+// probe) and the rest (break)
+void grid_children(const int* h, int M, int px, int py, int* survived, int* broke)
+{
+  for (int x = 0; x < M; x++) {
+    survived[x] = (x + px < M ? std::max(0, h[x + px] - py) : 0);
+    broke[x] = (x < px ? h[x] : std::min(h[x], py));
+  }
+}
+
+// Collect the canonical orientation of every staircase inside the (F + 1) x (A + 1) box
+void grid_enumerate(const tGrid2D& G, int x, int limit, int size, std::vector<int>& h, std::vector<std::vector<int>>& by_size)
+{
+  if (x > G.F || limit == 0) {
+    if (size == 0)
+      return;
+    std::vector<int> conj(G.M);
+    grid_conjugate(h.data(), G.M, conj.data());
+    if (!grid_conjugate_in_box(G, h.data(), conj.data()) || G.rank(h.data()) <= G.rank(conj.data()))
+      by_size[size].insert(by_size[size].end(), h.begin(), h.end());
+    return;
+  }
+  for (int v = limit; v >= 0; v--) {
+    h[x] = v;
+    grid_enumerate(G, x + 1, v, size + v, h, by_size);
+  }
+  h[x] = 0;
+}
+
+// Solve all staircases inside the (F + 1) x (A + 1) box, by increasing number of candidates (both children
+// of a probe are smaller); the states of one size are evaluated in parallel. Returns false if the tables
+// would exceed GRID_MAX_BYTES.
+bool grid_solve(tGrid2D& G, int nthreads)
+{
+  const int INF = INT_MAX / 4;
+  const int W = G.F + 1;
+  const int H = G.A + 1;
+  G.M = std::max(W, H);
+  G.binom.assign(W + H + 1, std::vector<long long>(W + 2, 0));
+  for (int n = 0; n <= W + H; n++) {
+    G.binom[n][0] = 1;
+    for (int k = 1; k <= std::min(n, W + 1); k++)
+      G.binom[n][k] = G.binom[n - 1][k - 1] + (k <= n - 1 ? G.binom[n - 1][k] : 0);
+  }
+  G.per_level = G.binom[W + H][W];
+  int depth = 0;
+  while ((1 << depth) < W)
+    depth++;
+  for (int k = 0; (1 << k) < H; k++)
+    depth++;
+  G.levels = std::min(G.E, depth);
+  if (G.per_level * (2 * (G.levels + 1) + G.M) * static_cast<long long>(sizeof(int)) > GRID_MAX_BYTES)
+    return false;
+  G.V.assign((G.levels + 1) * G.per_level, INF);
+  G.P.assign((G.levels + 1) * G.per_level, 0);
+
+  // canonical staircases in the box, grouped by size
+  const int cells = (G.F + 1) * (G.A + 1);
+  std::vector<std::vector<int>> by_size(cells + 1);
+  std::vector<int> h(G.M, 0);
+  grid_enumerate(G, 0, G.A + 1, 0, h, by_size);
+
+  for (int e = 0; e <= G.levels; e++) {
+    for (int size = 1; size <= cells; size++) {
+      const std::vector<int>& states = by_size[size];
+      const int n = static_cast<int>(states.size()) / G.M;
+      parallel_for(0, n, nthreads, [&](int b, int end) {
+        std::vector<int> survived(G.M), broke(G.M);
+        for (int i = b; i < end; i++) {
+          const int* hs = states.data() + static_cast<size_t>(i) * G.M;
+          const long long r = G.rank(hs);
+          if (size == 1) {
+            G.V[G.index(e, r)] = 0;
+            continue;
+          }
+          auto branches = [&](int px, int py, int& vs, int& vb) {
+            bool mirrored;
+            grid_children(hs, G.M, px, py, survived.data(), broke.data());
+            vs = G.V[G.index(e, grid_canonical(G, survived.data(), mirrored))];
+            vb = G.V[G.index(e - 1, grid_canonical(G, broke.data(), mirrored))];
+          };
+          int best = INF;
+          int probe = 0;
+          for (int px = 0; px < G.M && hs[px] > 0 && e > 0; px++) {
+            // within a column the survive part shrinks and the break part grows with py, so the best
+            // probe of the column sits at the crossover of the two branch values
+            int lo = (px == 0 ? 1 : 0);
+            int hi = hs[px] - 1;
+            if (lo > hi)
+              continue;
+            int vs, vb;
+            while (lo < hi) {
+              const int mid = (lo + hi) >> 1;
+              branches(px, mid, vs, vb);
+              if (vb >= vs)
+                hi = mid;
+              else
+                lo = mid + 1;
+            }
+            for (int py = std::max(px == 0 ? 1 : 0, lo - 1); py <= lo; py++) {
+              branches(px, py, vs, vb);
+              if (1 + std::max(vs, vb) < best) {
+                best = 1 + std::max(vs, vb);
+                probe = px * G.M + py;
+              }
+            }
+          }
+          G.V[G.index(e, r)] = best;
+          G.P[G.index(e, r)] = probe;
+        }
+      });
+    }
+  }
+  return true;
+}
+
+// Run the 2D policy with e eggs for threshold (tx, ty); returns the number of drops
+int run_grid_once(const tGrid2D& G, int e, int tx, int ty, std::vector<std::pair<int, int>>* pseq = nullptr)
+{
+  if (pseq != nullptr)
+    pseq->clear();
+  std::vector<int> h(G.M, 0), survived(G.M), broke(G.M);
+  std::fill(h.begin(), h.begin() + G.F + 1, G.A + 1);
+  int ox = 0;
+  int oy = 0;
+  int drops = 0;
+  while (std::accumulate(h.begin(), h.end(), 0) > 1) {
+    bool mirrored;
+    const int p = G.P[G.index(e, grid_canonical(G, h.data(), mirrored))];
+    int px = p / G.M;
+    int py = p % G.M;
+    if (mirrored)
+      std::swap(px, py);
+    if (pseq != nullptr)
+      pseq->push_back({ox + px, oy + py});
+    grid_children(h.data(), G.M, px, py, survived.data(), broke.data());
+    if (ox + px <= tx && oy + py <= ty) {
+      h.swap(survived);
+      ox += px;
+      oy += py;
+    } else {
+      h.swap(broke);
+      e--;
+    }
+    drops++;
+  }
+  return drops;
+}
+
+// Threshold search in a partial order of up to 64 test configurations: breaking at x implies breaking at
+// every successor of x, so the configurations that survive form an unknown down-set. Everything below a
+// surviving probe is known to survive and everything above a broken one to break, so a state only keeps
+// the undetermined configurations R (a bitmask) with its egg count; the candidates are exactly the
+// down-sets of the order induced on R. A probe x in R leaves R minus up[x] after a break and R minus down[x]
+// after a survive (up[x] and down[x] include x).
+struct tPoset {
+  int n;
+  std::vector<uint64_t> up;    // x and its successors
+  std::vector<uint64_t> down;  // x and its predecessors
+  std::vector<std::unordered_map<uint64_t, std::pair<int, int>>> memo;  // per e: R -> (drops, probe)
+};
+
+// Build the order from the cover relation "i is directly below j" (edges) by transitive closure; the
+// configurations are numbered so that every edge goes upwards
+void poset_from_edges(tPoset& P, int n, const std::vector<std::pair<int, int>>& edges)
+{
+  P.n = n;
+  P.up.assign(n, 0);
+  P.down.assign(n, 0);
+  for (int x = 0; x < n; x++)
+    P.up[x] = P.down[x] = 1ULL << x;
+  std::vector<std::vector<int>> above(n);
+  for (const auto& edge : edges)
+    above[edge.first].push_back(edge.second);
+  for (int x = n - 1; x >= 0; x--) {
+    for (int y : above[x])
+      P.up[x] |= P.up[y];
+  }
+  for (int x = 0; x < n; x++) {
+    for (int y = 0; y < n; y++) {
+      if ((P.up[x] >> y) & 1)
+        P.down[y] |= 1ULL << x;
+    }
+  }
+}
+
+// Minimax drops for the undetermined set R with e eggs. Probes are pruned as soon as one branch already
+// reaches the best value.
+int poset_value(tPoset& P, int e, uint64_t R)
+{
+  if (R == 0)
+    return 0;
+  if (e == 0)
+    return INT_MAX / 4;
+  auto it = P.memo[e].find(R);
+  if (it != P.memo[e].end())
+    return it->second.first;
+  int best = INT_MAX / 4;
+  int probe = -1;
+  for (uint64_t rest = R; rest != 0; rest &= rest - 1) {
+    const int x = __builtin_ctzll(rest);
+    const int vs = poset_value(P, e, R & ~P.down[x]);
+    if (1 + vs >= best)
+      continue;
+    const int v = 1 + std::max(vs, poset_value(P, e - 1, R & ~P.up[x]));
+    if (v < best) {
+      best = v;
+      probe = x;
+    }
+  }
+  P.memo[e][R] = {best, probe};
+  return best;
+}
+
+// Minimax drops per egg allocation for one building: table[e] for e = 0..E (INT_MAX / 4 if infeasible)
+std::vector<int> building_table(int F, int E)
+{
+  std::vector<int> table(E + 1);
+  for (int e = 0; e <= E; e++) {
+    const long long d = bounded_drops(e, F + 1LL);
+    table[e] = (d >= INT_MAX / 4 ? INT_MAX / 4 : static_cast<int>(d));
+  }
+  return table;
+}
+
+// Static egg allocation over buildings by convolution over eggs: total (min-plus) or maximum (min-max)
+// drops. best[e] is the optimum for e eggs over the buildings so far, split[i][e] the eggs given to
+// building i.
+int allocate_eggs(const std::vector<std::vector<int>>& tables, int E, bool use_max, std::vector<int>& allocation)
+{
+  const int k = static_cast<int>(tables.size());
+  std::vector<int> best(tables[0]);
+  std::vector<std::vector<int>> split(k, std::vector<int>(E + 1, 0));
+  for (int e = 0; e <= E; e++)
+    split[0][e] = e;
+  for (int i = 1; i < k; i++) {
+    std::vector<int> next(E + 1, INT_MAX / 4);
+    for (int e = 0; e <= E; e++) {
+      for (int mine = 0; mine <= e; mine++) {
+        const int a = best[e - mine];
+        const int b = tables[i][mine];
+        const int v = (use_max ? std::max(a, b) : std::min(a + b, INT_MAX / 4));
+        if (v < next[e]) {
+          next[e] = v;
+          split[i][e] = mine;
+        }
+      }
+    }
+    best.swap(next);
+  }
+  allocation.assign(k, 0);
+  for (int i = k - 1, e = E; i >= 0; i--) {
+    allocation[i] = split[i][e];
+    e -= split[i][e];
+  }
+  return best[E];
+}
+
+// Sequential search with carried-over eggs: buildings are finished one at a time in the given order and
+// the eggs that survive one building are used for the next. after[e] is the worst-case total for the
+// remaining buildings with e eggs; per building, V(w, e) for w candidates is 1 + max(V(x, e - 1),
+// V(w - x, e)) minimized over x with V(1, e) = after[e]. The crossover of the two branches is found by
+// binary search as in the crossover scan of the economic model. first_drop receives the first floor of
+// the first building.
+int carry_over_total(const std::vector<int>& floors, const std::vector<int>& order, int E, int& first_drop)
+{
+  std::vector<int> after(E + 1, 0);
+  first_drop = 0;
+  for (int pos = static_cast<int>(order.size()) - 1; pos >= 0; pos--) {
+    const int W = floors[order[pos]] + 1;
+    std::vector<std::vector<int>> V(E + 1, std::vector<int>(W + 1, INT_MAX / 4));
+    for (int e = 0; e <= E; e++) {
+      V[e][1] = after[e];
+      for (int w = 2; w <= W && e > 0; w++) {
+        // V[e - 1][x] grows with x and V[e][w - x] shrinks with x
+        int lo = 1;
+        int hi = w - 1;
+        while (lo < hi) {
+          const int mid = (lo + hi) / 2;
+          if (V[e - 1][mid] >= V[e][w - mid])
+            hi = mid;
+          else
+            lo = mid + 1;
+        }
+        int best = INT_MAX / 4;
+        int best_x = lo;
+        for (int x = std::max(1, lo - 1); x <= std::min(w - 1, lo); x++) {
+          const int v = std::min(1 + std::max(V[e - 1][x], V[e][w - x]), INT_MAX / 4);
+          if (v < best) {
+            best = v;
+            best_x = x;
+          }
+        }
+        V[e][w] = best;
+        if (pos == 0 && e == E && w == W)
+          first_drop = best_x;
+      }
+    }
+    for (int e = 0; e <= E; e++)
+      after[e] = V[e][W];
+  }
+  return after[E];
+}
+
+// Quantile objective: the p-quantile of the drops is at most d iff the policy localizes limit floors of
+// prior mass >= p within d drops. M(e, lb, ub, r) is the largest such mass within r drops from a state,
+// i.e. the drop-count distribution of the best policy cut at r, and it combines the children by shift
+// and merge: M(e, lb, ub, r) = max over x of M(e - 1, lb, x, r - 1) + M(e, x, ub, r - 1). Only the
+// prefix r < bounded_drops(e, width) is stored, since beyond it the whole mass of the state is reached;
+// one egg forces the bottom-up scan, whose prefix is read off the prior directly.
+struct tQuantile {
+  int F, E;
+  std::vector<double> cumulative;              // prior mass of limit floors 0..f-1
+  std::vector<std::vector<int>> len;           // [e][w] stored prefix length
+  std::vector<std::vector<long long>> offset;  // [e][w] start of the (r, lb) block, lb innermost
+  std::vector<std::vector<double>> M;          // [e] masses
+
+  double mass(int lb, int ub) const { return cumulative[ub] - cumulative[lb]; }
+
+  double at(int e, int lb, int ub, int r) const {
+    const int w = ub - lb;
+    if (w == 1)
+      return mass(lb, ub);
+    if (e == 0 || r == 0)
+      return 0.0;
+    if (r >= len[e][w])
+      return mass(lb, ub);
+    if (e == 1)
+      return mass(lb, lb + r);
+    return M[e][offset[e][w] + static_cast<long long>(r - 1) * (F + 2 - w) + lb];
+  }
+
+  // M(e, lb, lb + w, r) for all lb = 0..F + 1 - w, pointing into the table or else filled into scratch
+  const double* row(int e, int w, int r, std::vector<double>& scratch) const {
+    if (e >= 2 && w >= 2 && r >= 1 && r < len[e][w])
+      return &M[e][offset[e][w] + static_cast<long long>(r - 1) * (F + 2 - w)];
+    scratch.resize(F + 2 - w);
+    for (int lb = 0; lb + w <= F + 1; lb++)
+      scratch[lb] = at(e, lb, lb + w, r);
+    return scratch.data();
+  }
+};
+
+// Best split and its mass for budget r >= 1 with e >= 2 eggs (leftmost on ties)
+std::pair<double, int> quantile_best(const tQuantile& Q, int e, int lb, int ub, int r)
+{
+  double best = -1.0;
+  int best_x = lb + 1;
+  for (int x = lb + 1; x < ub; x++) {
+    const double v = Q.at(e - 1, lb, x, r - 1) + Q.at(e, x, ub, r - 1);
+    if (v > best + 1e-12) {
+      best = v;
+      best_x = x;
+    }
+  }
+  return {best, best_x};
+}
+
+// Fill the stored prefixes budget by budget; within a budget all states are independent. For a width w
+// and a split k = x - lb, both children are contiguous rows over lb, so the max runs along lb.
+void quantile_solve(tQuantile& Q, int nthreads)
+{
+  const int F = Q.F;
+  Q.len.assign(Q.E + 1, std::vector<int>(F + 2, 0));
+  Q.offset.assign(Q.E + 1, std::vector<long long>(F + 2, 0));
+  Q.M.assign(Q.E + 1, {});
+  for (int e = 1; e <= Q.E; e++) {
+    long long total = 0;
+    for (int w = 2; w <= F + 1; w++) {
+      Q.len[e][w] = static_cast<int>(bounded_drops(e, w));
+      Q.offset[e][w] = total;
+      if (e >= 2)
+        total += static_cast<long long>(Q.len[e][w] - 1) * (F + 2 - w);
+    }
+    Q.M[e].assign(total, 0.0);
+  }
+  for (int r = 1; r < Q.len[std::min(Q.E, 2)][F + 1]; r++) {
+    for (int e = 2; e <= Q.E; e++) {
+      parallel_for(2, F + 2, nthreads, [&](int b, int end) {
+        std::vector<double> scratch_break;
+        std::vector<double> scratch_survive;
+        for (int w = b; w < end; w++) {
+          if (r >= Q.len[e][w])
+            continue;
+          const int n = F + 2 - w;
+          double* best = &Q.M[e][Q.offset[e][w] + static_cast<long long>(r - 1) * n];
+          std::fill(best, best + n, 0.0);
+          for (int k = 1; k < w; k++) {
+            const double* broken = Q.row(e - 1, k, r - 1, scratch_break);
+            const double* survived = Q.row(e, w - k, r - 1, scratch_survive) + k;
+            for (int lb = 0; lb < n; lb++)
+              best[lb] = std::max(best[lb], broken[lb] + survived[lb]);
+          }
+        }
+      });
+    }
+  }
+}
+
+// Drops for limit floor L under the budget-r policy; once the budget is spent (or the whole mass of the
+// state fits in it) the classic minimax split finishes the search. budget = 0 is the minimax policy.
+int run_quantile_once(const tQuantile& Q, int e, int budget, int L)
+{
+  int lb = 0;
+  int ub = Q.F + 1;
+  int r = budget;
+  int drops = 0;
+  while (ub - lb > 1) {
+    const int w = ub - lb;
+    int x = 0;
+    if (r == 0 || e == 1 || r >= Q.len[e][w] || Q.at(e, lb, ub, r) <= 0.0) {
+      const long long d = bounded_drops(e, w);
+      x = lb + static_cast<int>(std::min<long long>(reach_floors(e - 1, d - 1) + 1, w - 1));
+    } else {
+      x = quantile_best(Q, e, lb, ub, r).second;
+    }
+    drops++;
+    r = std::max(r - 1, 0);
+    if (x > L) {
+      e--;
+      ub = x;
+    } else {
+      lb = x;
+    }
+  }
+  return drops;
+}
+
+// Expected drops under a prior on the limit floor: P(e, lb, ub) sums weight * drops over the limit floors
+// lb..ub-1, so P = W(lb, ub) + min over a of P(e - 1, lb, a) + P(e, a, ub) with W the interval weight.
+// A state only depends on the weights inside its interval, and W is accumulated inside the interval too,
+// so after a change of a few weights exactly the states containing a changed floor need re-solving.
+struct tPriorTables {
+  int F, E;
+  std::vector<double> weight;  // limit floors 0..F
+  tDense<double> W;            // interval weights (level 1 only)
+  tDense<double> P;
+  tDense<int> A;
+};
+
+// Solve one state; narrower states at level e and all of level e - 1 must be solved (leftmost on ties).
+// States of width <= tolerance + 1 are terminal, and a single egg may drop up to tolerance + 1 above lb.
+void prior_solve_state(tPriorTables& T, int e, int lb, int ub)
+{
+  T.W.at(1, lb, ub) = (ub - lb == 1 ? T.weight[lb] : T.W.at(1, lb, ub - 1) + T.weight[ub - 1]);
+  if (ub - lb <= tState::tolerance + 1) {
+    T.P.at(e, lb, ub) = 0.0;
+    T.A.at(e, lb, ub) = lb;
+    return;
+  }
+  if (e == 1) {
+    int action = lb + 1;
+    for (int a = lb + 2; a <= lb + tState::tolerance + 1; a++) {
+      if (T.P.at(e, a, ub) < T.P.at(e, action, ub))
+        action = a;
+    }
+    T.P.at(e, lb, ub) = T.W.at(1, lb, ub) + T.P.at(e, action, ub);
+    T.A.at(e, lb, ub) = action;
+    return;
+  }
+  double best = std::numeric_limits<double>::max();
+  int action = lb + 1;
+  for (int a = lb + 1; a < ub; a++) {
+    const double value = T.P.at(e - 1, lb, a) + T.P.at(e, a, ub);
+    if (value < best) {
+      best = value;
+      action = a;
+    }
+  }
+  T.P.at(e, lb, ub) = T.W.at(1, lb, ub) + best;
+  T.A.at(e, lb, ub) = action;
+}
+
+// Solve all states, level by level and by increasing width
+void prior_solve(tPriorTables& T, int nthreads)
+{
+  T.W.resize(T.F, 1, 0.0);
+  T.P.resize(T.F, T.E, 0.0);
+  T.A.resize(T.F, T.E, 0);
+  for (int e = 1; e <= T.E; e++) {
+    for (int w = 1; w <= T.F + 1; w++) {
+      parallel_for(0, T.F + 2 - w, nthreads, [&](int b, int end) {
+        for (int lb = b; lb < end; lb++)
+          prior_solve_state(T, e, lb, lb + w);
+      });
+    }
+  }
+}
+
+// Apply new weights for a few floors and re-solve only the states whose interval contains one of them,
+// in the same dependency order. Returns the number of re-solved states; changed counts their new actions.
+long long prior_update(tPriorTables& T, const std::vector<std::pair<int, double>>& delta, int nthreads, long long& changed)
+{
+  std::vector<int> count(T.F + 2, 0);  // changed floors among 0..f-1
+  for (const auto& d : delta)
+    T.weight[d.first] = d.second;
+  for (const auto& d : delta)
+    count[d.first + 1] = 1;
+  for (int f = 1; f <= T.F + 1; f++)
+    count[f] += count[f - 1];
+
+  long long resolved = 0;
+  changed = 0;
+  std::mutex guard;
+  std::vector<int> affected;
+  for (int e = 1; e <= T.E; e++) {
+    for (int w = 1; w <= T.F + 1; w++) {
+      affected.clear();
+      for (int lb = 0; lb + w <= T.F + 1; lb++) {
+        if (count[lb + w] > count[lb])
+          affected.push_back(lb);
+      }
+      resolved += affected.size();
+      parallel_for(0, static_cast<int>(affected.size()), nthreads, [&](int b, int end) {
+        long long local = 0;
+        for (int i = b; i < end; i++) {
+          const int before = T.A.at(e, affected[i], affected[i] + w);
+          prior_solve_state(T, e, affected[i], affected[i] + w);
+          local += (T.A.at(e, affected[i], affected[i] + w) != before ? 1 : 0);
+        }
+        std::lock_guard<std::mutex> lock(guard);
+        changed += local;
+      });
+    }
+  }
+  return resolved;
+}
+
+// K priors solved at once: every state holds one lane per prior, stored next to each other, so the index
+// arithmetic and the table traffic of the action loop are shared and the per-lane argmin is a branch-free
+// select over contiguous lanes. Lanes go in blocks of PRIOR_LANES (one cache line of doubles), a fixed
+// trip count the compiler vectorizes; K is padded with zero-weight lanes.
+const int PRIOR_LANES = 8;
+
+struct tPriorBatch {
+  int F, E, K;
+  size_t per_level;
+  std::vector<double> weight;  // [f * K + k]
+  std::vector<double> W;       // interval weights, [index(1, lb, ub) + k]
+  std::vector<double> P;
+  std::vector<int> A;
+
+  size_t index(int e, int lb, int ub) const {
+    const size_t w = ub - lb;
+    return ((e - 1) * per_level + (w - 1) * (F + 2) - (w - 1) * w / 2 + lb) * K;
+  }
+};
+
+// Solve the K priors of B.weight, level by level and by increasing width. For a width w and a split
+// k = a - lb, the break and survive children of all states of the width are contiguous rows over
+// (lb, lane), so the min runs as a stream over the row in blocks of PRIOR_LANES held in local arrays.
+void prior_batch_solve(tPriorBatch& B, int nthreads)
+{
+  const int K = B.K;
+  B.per_level = static_cast<size_t>(B.F + 1) * (B.F + 2) / 2;
+  B.W.assign(B.per_level * K, 0.0);
+  B.P.assign(B.per_level * B.E * K, 0.0);
+  B.A.assign(B.per_level * B.E * K, 0);
+  for (int lb = 0; lb <= B.F; lb++) {
+    for (int k = 0; k < K; k++)
+      B.W[B.index(1, lb, lb + 1) + k] = B.weight[static_cast<size_t>(lb) * K + k];
+  }
+  for (int w = 2; w <= B.F + 1; w++) {
+    for (int lb = 0; lb + w <= B.F + 1; lb++) {
+      for (int k = 0; k < K; k++)
+        B.W[B.index(1, lb, lb + w) + k] = B.W[B.index(1, lb, lb + w - 1) + k] + B.weight[static_cast<size_t>(lb + w - 1) * K + k];
+    }
+  }
+
+  std::vector<double> best;
+  std::vector<double> action;  // kept as doubles so that the select stays in one vector type
+  for (int e = 1; e <= B.E; e++) {
+    for (int lb = 0; lb <= B.F; lb++) {
+      for (int k = 0; k < K; k++)
+        B.A[B.index(e, lb, lb + 1) + k] = lb;
+    }
+    for (int w = 2; w <= B.F + 1; w++) {
+      const int n = (B.F + 2 - w) * K;
+      const double* weights = &B.W[B.index(1, 0, w)];
+      double* p = &B.P[B.index(e, 0, w)];
+      int* x = &B.A[B.index(e, 0, w)];
+      if (w <= tState::tolerance + 1) {
+        // localized within the tolerance (P stays 0)
+        for (int i = 0; i < n; i++)
+          x[i] = i / K;
+        continue;
+      }
+      if (e == 1) {
+        // a single egg drops at most tolerance + 1 floors above lb (leftmost on ties)
+        const double* survived = &B.P[B.index(e, 0, w - 1)] + K;
+        for (int i = 0; i < n; i++) {
+          p[i] = survived[i];
+          x[i] = i / K + 1;
+        }
+        for (int split = 2; split <= tState::tolerance + 1; split++) {
+          survived = &B.P[B.index(e, 0, w - split)] + static_cast<size_t>(split) * K;
+          for (int i = 0; i < n; i++) {
+            if (survived[i] < p[i]) {
+              p[i] = survived[i];
+              x[i] = i / K + split;
+            }
+          }
+        }
+        for (int i = 0; i < n; i++)
+          p[i] += weights[i];
+        continue;
+      }
+      best.assign(n, std::numeric_limits<double>::max());
+      action.assign(n, 0.0);
+      parallel_for(0, n / PRIOR_LANES, nthreads, [&](int b, int end) {
+        for (int split = 1; split < w; split++) {
+          const double* broken = &B.P[B.index(e - 1, 0, split)];
+          const double* survived = &B.P[B.index(e, 0, w - split)] + static_cast<size_t>(split) * K;
+          const double floor = split;
+          for (int block = b; block < end; block++) {
+            const int i0 = block * PRIOR_LANES;
+            double lane_best[PRIOR_LANES];
+            double lane_action[PRIOR_LANES];
+            for (int j = 0; j < PRIOR_LANES; j++) {
+              lane_best[j] = best[i0 + j];
+              lane_action[j] = action[i0 + j];
+            }
+            for (int j = 0; j < PRIOR_LANES; j++) {
+              const double value = broken[i0 + j] + survived[i0 + j];
+              lane_action[j] = (value < lane_best[j] ? floor : lane_action[j]);
+              lane_best[j] = std::min(value, lane_best[j]);
+            }
+            for (int j = 0; j < PRIOR_LANES; j++) {
+              best[i0 + j] = lane_best[j];
+              action[i0 + j] = lane_action[j];
+            }
+          }
+        }
+      }, 16);
+      for (int i = 0; i < n; i++) {
+        p[i] = weights[i] + best[i];
+        x[i] = i / K + static_cast<int>(action[i]);
+      }
+    }
+  }
+}
+
+// Tie regret of a solved dense state: among the minimax-optimal drops, the spread between the smallest
+// and the largest summed cost (children following the solved policy), from V and S alone. The ties are
+// collected as in dense_solve_state: from the crossover outwards until one branch alone exceeds V.
+long long tie_regret_state(int e, int lb, int ub, const tDenseConfig& cfg, const tDense<int>& V,
+                           const tDense<long long>& S, int& ties)
+{
+  const tState s = {e, lb, ub};
+  const long long w = ub - lb;
+  ties = 0;
+  if (s.isterminal())
+    return 0;
+  const int target = V.at(e, lb, ub);
+  long long lowest = LLONG_MAX;
+  long long highest = LLONG_MIN;
+  auto tie = [&](long long summed) {
+    ties++;
+    lowest = std::min(lowest, summed);
+    highest = std::max(highest, summed);
+  };
+  if (e == 1) {
+    for (int a = tState::next_allowed(lb + 1); a < ub; a = tState::next_allowed(a + 1)) {
+      if (a > tState::next_allowed(lb + 1) && !tState({0, lb, a}).isterminal())
+        break;
+      if (s.cost(a, lb) + V.at(e, a, ub) == target)
+        tie(w * s.cost(a, lb) + S.at(e, a, ub));
+    }
+    return highest - lowest;
+  }
+  int lo = lb + 1;
+  int hi = ub - 1;
+  while (lo < hi) {
+    const int mid = (lo + hi) >> 1;
+    if (V.at(e - 1, lb, mid) >= V.at(e, mid, ub))
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  lo = tState::next_allowed(lo);
+  for (tAllowedWalk walk(lo, true); walk.floor < ub; walk.next()) {
+    const int a = walk.floor;
+    if (V.at(e - 1, lb, a) + cfg.min_cost > target)
+      break;
+    if (s.cost(a, lb) + std::max(V.at(e - 1, lb, a), V.at(e, a, ub)) == target)
+      tie(w * s.cost(a, lb) + S.at(e - 1, lb, a) + S.at(e, a, ub));
+  }
+  for (tAllowedWalk walk(lo - 1, false); walk.floor > lb; walk.next()) {
+    const int a = walk.floor;
+    if (V.at(e, a, ub) + cfg.min_cost > target)
+      break;
+    if (s.cost(a, lb) + std::max(V.at(e - 1, lb, a), V.at(e, a, ub)) == target)
+      tie(w * s.cost(a, lb) + S.at(e - 1, lb, a) + S.at(e, a, ub));
+  }
+  return highest - lowest;
+}
+
+// Bounds on the summed drops over minimax-optimal policies (unit costs, so states reduce to widths).
+// A policy is minimax-optimal for (e, w) if its worst case stays within the budget D[e][w]; below the root
+// a state with budget b may use any drop whose worst case fits in b - 1, not only its own tied drops:
+//   Smin(e, w, b) = w + min over a with max(D[e - 1][a], D[e][w - a]) < b of Smin(e - 1, a, b - 1) + Smin(e, w - a, b - 1)
+// and likewise Smax. The tied (subgame-perfect) policies of --left / --right / --tiebreak only use drops
+// with 1 + max(...) = D[e][w] in every state, which gives the narrower bounds Tmin, Tmax. One egg has a
+// single policy, the scan from below.
+struct tMeanBounds {
+  int F, E, B;                                   // B: largest budget needed for e >= 2
+  std::vector<std::vector<int>> D;               // unit minimax drops [e][w]
+  std::vector<long long> scan;                   // summed drops of the one-egg scan [w]
+  std::vector<std::vector<long long>> Smin, Smax;  // [e][w * (B + 1) + b]
+  std::vector<std::vector<int>> Xmin, Xmax;        // witness drops (offsets from lb)
+  std::vector<std::vector<long long>> Tmin, Tmax;  // [e][w]
+
+  long long smin(int e, int w, int b) const { return e == 1 ? scan[w] : Smin[e][w * (B + 1) + b]; }
+  long long smax(int e, int w, int b) const { return e == 1 ? scan[w] : Smax[e][w * (B + 1) + b]; }
+  long long tmin(int e, int w) const { return e == 1 ? scan[w] : Tmin[e][w]; }
+  long long tmax(int e, int w) const { return e == 1 ? scan[w] : Tmax[e][w]; }
+};
+
+void mean_bounds_solve(tMeanBounds& M)
+{
+  const int F = M.F;
+  const long long inf = LLONG_MAX / 4;
+  unit_minimax_table(F, M.E, M.D);
+  M.B = (M.E >= 2 ? M.D[2][F + 1] : 0);
+  M.scan.assign(F + 2, 0);
+  for (int w = 2; w <= F + 1; w++)
+    M.scan[w] = w + M.scan[w - 1];
+  M.Smin.assign(M.E + 1, {});
+  M.Smax.assign(M.E + 1, {});
+  M.Xmin.assign(M.E + 1, {});
+  M.Xmax.assign(M.E + 1, {});
+  M.Tmin.assign(M.E + 1, {});
+  M.Tmax.assign(M.E + 1, {});
+  for (int e = 2; e <= M.E; e++) {
+    const size_t cells = static_cast<size_t>(F + 2) * (M.B + 1);
+    M.Smin[e].assign(cells, inf);
+    M.Smax[e].assign(cells, -inf);
+    M.Xmin[e].assign(cells, 0);
+    M.Xmax[e].assign(cells, 0);
+    M.Tmin[e].assign(F + 2, 0);
+    M.Tmax[e].assign(F + 2, 0);
+    for (int b = 0; b <= M.B; b++) {
+      M.Smin[e][1 * (M.B + 1) + b] = 0;
+      M.Smax[e][1 * (M.B + 1) + b] = 0;
+    }
+    for (int w = 2; w <= F + 1; w++) {
+      long long tlo = inf;
+      long long thi = -inf;
+      for (int a = 1; a < w; a++) {
+        const int worst = 1 + std::max(M.D[e - 1][a], M.D[e][w - a]);
+        if (worst == M.D[e][w]) {
+          tlo = std::min(tlo, w + M.tmin(e - 1, a) + M.tmin(e, w - a));
+          thi = std::max(thi, w + M.tmax(e - 1, a) + M.tmax(e, w - a));
+        }
+        for (int b = std::max(worst, 1); b <= M.B; b++) {
+          const size_t i = static_cast<size_t>(w) * (M.B + 1) + b;
+          const long long lo = w + M.smin(e - 1, a, b - 1) + M.smin(e, w - a, b - 1);
+          const long long hi = w + M.smax(e - 1, a, b - 1) + M.smax(e, w - a, b - 1);
+          if (lo < M.Smin[e][i]) {
+            M.Smin[e][i] = lo;
+            M.Xmin[e][i] = a;
+          }
+          if (hi > M.Smax[e][i]) {
+            M.Smax[e][i] = hi;
+            M.Xmax[e][i] = a;
+          }
+        }
+      }
+      M.Tmin[e][w] = tlo;
+      M.Tmax[e][w] = thi;
+    }
+  }
+}
+
+// Drops of the witness policy (least or most summed drops) of (e, F) for limit floor L
+int run_mean_bound_witness(const tMeanBounds& M, int e, int F, bool most, int L, std::vector<int>* aseq = nullptr)
+{
+  int lb = 0;
+  int ub = F + 1;
+  int b = M.D[e][F + 1];
+  int drops = 0;
+  if (aseq != nullptr)
+    aseq->clear();
+  while (ub - lb > 1) {
+    const size_t i = static_cast<size_t>(ub - lb) * (M.B + 1) + b;
+    const int a = lb + (e == 1 ? 1 : (most ? M.Xmax[e][i] : M.Xmin[e][i]));
+    if (aseq != nullptr)
+      aseq->push_back(a);
+    drops++;
+    b--;
+    if (a > L) {
+      e--;
+      ub = a;
+    } else {
+      lb = a;
+    }
+  }
+  return drops;
+}
+
+// Immutable solved policy for embedding: the dense value and action tables of one (F, E), never modified
+// after construction, so any number of threads can look up drops concurrently.
+struct tPolicy {
+  tPolicy(int F_, int E_, const tDenseConfig& cfg, int version_) : F(F_), E(E_), version(version_) {
+    tDense<long long> S;
+    dense_scan(F, E, cfg, V, A, S);
+  }
+
+  // drops to localize limit floor L with e eggs, one table lookup per drop
+  int run(int e, int L) const {
+    tState s = {e, 0, F + 1};
+    int drops = 0;
+    while (!s.isterminal()) {
+      s.eggdrop(A.at(s.eggs, s.lb, s.ub), L);
+      drops++;
+    }
+    return drops;
+  }
+
+  const int F;
+  const int E;
+  const int version;
+  tDense<int> V;
+  tDense<int> A;
+};
+
+// Read-copy-update handle for a tPolicy. A reader announces the current epoch in its own slot, loads the
+// policy pointer, uses it and clears the slot: a fixed number of atomic loads and stores, so lookups are
+// wait-free and never blocked by a swap. The writer exchanges the pointer, advances the epoch and retires
+// the old policy; a retired policy is deleted once no slot announces an epoch older than its retirement
+// (all atomics sequentially consistent, so a reader that announces later sees the new pointer).
+const int RCU_MAX_READERS = 64;
+
+struct tPolicyHandle {
+  struct alignas(64) tSlot {
+    std::atomic<uint64_t> epoch{0};  // 0 = not reading
+  };
+
+  explicit tPolicyHandle(const tPolicy* initial) : current(initial) {}
+
+  ~tPolicyHandle() {
+    for (const auto& retired : retired_list)
+      delete retired.first;
+    delete current.load();
+  }
+
+  const tPolicy* enter(int reader) {
+    slots[reader].epoch.store(epoch.load());
+    return current.load();
+  }
+
+  void leave(int reader) {
+    slots[reader].epoch.store(0);
+  }
+
+  // Publish a new policy (single writer); returns the number of policies reclaimed so far by this call
+  int swap(const tPolicy* next) {
+    const tPolicy* old = current.exchange(next);
+    const uint64_t retired_at = epoch.fetch_add(1) + 1;
+    retired_list.push_back({old, retired_at});
+    return reclaim();
+  }
+
+  int reclaim() {
+    uint64_t oldest = epoch.load();
+    for (const auto& slot : slots) {
+      const uint64_t announced = slot.epoch.load();
+      if (announced != 0)
+        oldest = std::min(oldest, announced);
+    }
+    int reclaimed = 0;
+    for (size_t i = 0; i < retired_list.size(); ) {
+      if (retired_list[i].second <= oldest) {
+        delete retired_list[i].first;
+        retired_list[i] = retired_list.back();
+        retired_list.pop_back();
+        reclaimed++;
+      } else {
+        i++;
+      }
+    }
+    return reclaimed;
+  }
+
+  std::atomic<const tPolicy*> current;
+  std::atomic<uint64_t> epoch{1};
+  tSlot slots[RCU_MAX_READERS];
+  std::vector<std::pair<const tPolicy*, uint64_t>> retired_list;  // writer only
+};
+
+// Audit of logged executions. A log is a flat array of 32-bit words, one per observed drop:
+//   word = floor << 2 | broke << 1 | end
+// where end marks the last drop of an execution. Every execution starts from (E, 0, F + 1) and is replayed
+// against the solved tables with one lookup per step.
+struct tAuditCounts {
+  long long executions = 0;
+  long long steps = 0;
+  long long nonoptimal = 0;    // drops whose worst case exceeds V of their state (wasted drops included)
+  long long wasted = 0;        // drops whose outcome was already known, after localization, or without eggs
+  long long inconsistent = 0;  // executions with an outcome that contradicts earlier ones (replay stops there)
+  long long exhausted = 0;     // executions that ran out of eggs before the limit floor was localized
+  long long incomplete = 0;    // executions that end early with eggs left
+  long long extra = 0;         // cost above V of the start state, summed over localized executions
+  long long over = 0;          // executions with extra cost
+
+  void add(const tAuditCounts& other) {
+    executions += other.executions;
+    steps += other.steps;
+    nonoptimal += other.nonoptimal;
+    wasted += other.wasted;
+    inconsistent += other.inconsistent;
+    exhausted += other.exhausted;
+    incomplete += other.incomplete;
+    extra += other.extra;
+    over += other.over;
+  }
+};
+
+// Whether dropping from floor (strictly inside the interval of s, with eggs left) keeps the worst case at
+// V(s): cost + max(V(e - 1, lb, floor), V(e, floor, ub)) <= V(e, lb, ub), so every tied drop is optimal.
+// With one egg the break branch must be localized already, and forbidden floors are never optimal.
+bool audit_optimal_drop(const tState& s, int floor, const tDense<int>& V)
+{
+  if (tState::next_allowed(floor) != floor)
+    return false;
+  const int value = V.at(s.eggs, s.lb, s.ub);
+  const int survived = V.at(s.eggs, floor, s.ub);
+  if (s.eggs == 1)
+    return tState({0, s.lb, floor}).isterminal() && s.cost(floor, s.lb) + survived <= value;
+  return s.cost(floor, s.lb) + std::max(V.at(s.eggs - 1, s.lb, floor), survived) <= value;
+}
+
+// Replay the executions that start in words [begin, end); the last one may run past end
+void audit_range(const uint32_t* words, size_t begin, size_t end, size_t total, int F, int E,
+                 const tDense<int>& V, tAuditCounts& counts)
+{
+  const int target = V.at(E, 0, F + 1);
+  size_t i = begin;
+  while (i < end) {
+    tState s = {E, 0, F + 1, 0};
+    long long cost = 0;
+    bool contradicted = false;
+    bool ran_out = false;
+    bool last = false;
+    for (; i < total && !last; i++) {
+      const uint32_t word = words[i];
+      const int floor = static_cast<int>(word >> 2);
+      const bool broke = (word >> 1) & 1;
+      last = word & 1;
+      counts.steps++;
+      if (contradicted)
+        continue;
+      if (floor < 1 || floor > F || (floor <= s.lb && broke) || (floor >= s.ub && !broke)) {
+        // not a floor of the building, or an outcome that contradicts the interval known so far
+        contradicted = true;
+        continue;
+      }
+      cost += s.cost(floor, s.lb);
+      if (s.isterminal() || s.eggs <= 0 || floor <= s.lb || floor >= s.ub) {
+        counts.wasted++;
+        counts.nonoptimal++;
+      } else if (!audit_optimal_drop(s, floor, V)) {
+        counts.nonoptimal++;
+      }
+      s.observe(floor, broke);
+      ran_out = ran_out || s.isfailed();
+    }
+    counts.executions++;
+    if (contradicted) {
+      counts.inconsistent++;
+    } else if (ran_out) {
+      counts.exhausted++;
+    } else if (!s.isterminal()) {
+      counts.incomplete++;
+    } else if (cost > target) {
+      counts.extra += cost - target;
+      counts.over++;
+    }
+  }
+}
+
+// Audit a memory-mapped log across threads: each thread takes the executions that start in its chunk,
+// found by moving the chunk boundary past the next end word
+bool audit_log(const std::string& filename, int F, int E, const tDense<int>& V, int nthreads,
+               tAuditCounts& counts, size_t& nwords)
+{
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size % sizeof(uint32_t) != 0) {
+    close(fd);
+    return false;
+  }
+  nwords = info.st_size / sizeof(uint32_t);
+  counts = tAuditCounts();
+  if (nwords == 0) {
+    close(fd);
+    return true;
+  }
+  void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED)
+    return false;
+  const uint32_t* words = static_cast<const uint32_t*>(mapped);
+  madvise(mapped, info.st_size, MADV_SEQUENTIAL);
+
+  const int nchunks = static_cast<int>(std::max<size_t>(1, std::min<size_t>(nthreads, nwords / 4096 + 1)));
+  std::vector<size_t> start(nchunks + 1, nwords);
+  start[0] = 0;
+  for (int t = 1; t < nchunks; t++) {
+    size_t i = nwords * t / nchunks;
+    while (i < nwords && (words[i - 1] & 1) == 0)
+      i++;
+    start[t] = i;
+  }
+  std::vector<tAuditCounts> local(nchunks);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < nchunks; t++) {
+    workers.emplace_back([&, t]() {
+      audit_range(words, start[t], std::max(start[t], start[t + 1]), nwords, F, E, V, local[t]);
+    });
+  }
+  for (auto& worker : workers)
+    worker.join();
+  for (const auto& c : local)
+    counts.add(c);
+  munmap(mapped, info.st_size);
+  return true;
+}
+
+// Write n executions of the policy for uniform random limit floors. With probability fault per drop the
+// drop is a random floor of the interval (half of the faults), the outcome is flipped (a quarter), or a
+// floor outside the interval is dropped with its true outcome (a quarter; it contradicts the log if an
+// earlier outcome was flipped)
+bool generate_audit_log(const std::string& filename, int F, int E, const tDense<int>& A, long long n,
+                        double fault, unsigned int seed)
+{
+  std::ofstream file(filename, std::ios::binary);
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::vector<uint32_t> buffer;
+  for (long long k = 0; k < n && file; k++) {
+    const int L = static_cast<int>(rng() % (F + 1));
+    tState s = {E, 0, F + 1, 0};
+    while (!s.isterminal()) {
+      int floor = A.at(s.eggs, s.lb, s.ub);
+      bool broke = floor > L;
+      if (fault > 0.0 && uniform(rng) < fault) {
+        const int kind = static_cast<int>(rng() % 4);
+        const int outside = s.lb + (F + 1 - s.ub);  // floors 1..lb and ub..F
+        if (kind == 0) {
+          broke = !broke;
+        } else if (kind == 1 && outside > 0) {
+          const int j = static_cast<int>(rng() % outside);
+          floor = (j < s.lb ? j + 1 : s.ub + j - s.lb);
+          broke = floor > L;
+        } else {
+          floor = s.lb + 1 + static_cast<int>(rng() % (s.ub - s.lb - 1));
+          broke = floor > L;
+        }
+      }
+      s.observe(floor, broke);
+      const bool last = s.isterminal() || s.isfailed();
+      buffer.push_back(static_cast<uint32_t>(floor) << 2 | static_cast<uint32_t>(broke) << 1 | (last ? 1u : 0u));
+      if (last)
+        break;
+    }
+    if (buffer.size() >= (1 << 16)) {
+      file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(uint32_t));
+      buffer.clear();
+    }
+  }
+  file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(uint32_t));
+  return static_cast<bool>(file);
+}
+
+// Read a list of forbidden drop floors (whitespace separated) from a text file
+bool load_forbidden_floors(const std::string& filename, int F, std::vector<int>& forbidden)
+{
+  std::ifstream file(filename);
+  if (!file)
+    return false;
+  forbidden.clear();
+  int f;
+  while (file >> f) {
+    if (f < 1 || f > F)
+      return false;
+    forbidden.push_back(f);
+  }
+  return file.eof();
+}
+
+// Forbid each floor independently with probability fraction
+void random_forbidden_floors(int F, double fraction, unsigned int seed, std::vector<int>& forbidden)
+{
+  std::mt19937 rng(seed);
+  std::bernoulli_distribution coin(fraction);
+  forbidden.clear();
+  for (int f = 1; f <= F; f++) {
+    if (coin(rng))
+      forbidden.push_back(f);
+  }
+}
+
+// Time the dense minimax sweep at (F, E) for random forbidden sets, from sparse to dense
+void bench_forbidden(int F, int E, const tDenseConfig& cfg, unsigned int seed)
+{
+  const double fractions[] = {0.0, 0.001, 0.01, 0.1, 0.5, 0.9, 0.99};
+  std::vector<int> forbidden;
+  tDense<int> V;
+  tDense<int> A;
+  tDense<long long> S;
+  std::cout << "--- forbidden floor sweep benchmark, F = " << F << ", E = " << E << " ---" << std::endl;
+  for (double fraction : fractions) {
+    random_forbidden_floors(F, fraction, seed, forbidden);
+    set_forbidden_floors(F, forbidden);
+    auto clock_start = std::chrono::high_resolution_clock::now();
+    dense_scan(F, E, cfg, V, A, S);
+    auto clock_end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> clock_diff = clock_end - clock_start;
+    std::cout << "forbidden " << std::setw(6) << fraction << ": "
+              << std::setw(6) << F - forbidden.size() << " allowed, "
+              << "min max drops = " << std::setw(4) << V.at(E, 0, F + 1) << ", "
+              << "mean drops = " << std::setw(8) << static_cast<double>(S.at(E, 0, F + 1)) / (F + 1) << ", "
+              << "duration = " << clock_diff.count() << " s." << std::endl;
+  }
+  set_forbidden_floors(F, {});
+}
+
+// Read F whitespace separated nonnegative drop costs (floors 1..F, or distances 1..F) from a text file
+bool load_floor_costs(const std::string& filename, int F, std::vector<int>& costs)
+{
+  std::ifstream file(filename);
+  if (!file)
+    return false;
+  costs.assign(F + 1, 0);
+  for (int f = 1; f <= F; f++) {
+    if (!(file >> costs[f]) || costs[f] < 0)
+      return false;
+  }
+  return true;
+}
+
+// Read F + 1 whitespace separated nonnegative weights of the limit floors 0..F, normalized to sum 1
+bool load_prior(const std::string& filename, int F, std::vector<double>& prior)
+{
+  std::ifstream file(filename);
+  if (!file)
+    return false;
+  prior.assign(F + 1, 0.0);
+  double total = 0.0;
+  for (int f = 0; f <= F; f++) {
+    if (!(file >> prior[f]) || prior[f] < 0.0)
+      return false;
+    total += prior[f];
+  }
+  if (total <= 0.0)
+    return false;
+  for (double& weight : prior)
+    weight /= total;
+  return true;
+}
+
+// Read "floor weight" pairs (floors 0..F, nonnegative weights on the scale of the prior) from a text file
+bool load_prior_delta(const std::string& filename, int F, std::vector<std::pair<int, double>>& delta)
+{
+  std::ifstream file(filename);
+  if (!file)
+    return false;
+  delta.clear();
+  int f;
+  double weight;
+  while (file >> f >> weight) {
+    if (f < 0 || f > F || weight < 0.0)
+      return false;
+    delta.push_back({f, weight});
+  }
+  return file.eof() && !delta.empty();
+}
+
+// Read K priors of F + 1 nonnegative weights each (one after the other) from a text file, each normalized
+bool load_prior_batch(const std::string& filename, int F, std::vector<std::vector<double>>& priors)
+{
+  std::ifstream file(filename);
+  if (!file)
+    return false;
+  priors.clear();
+  std::vector<double> prior;
+  double weight;
+  while (file >> weight) {
+    if (weight < 0.0)
+      return false;
+    prior.push_back(weight);
+    if (static_cast<int>(prior.size()) == F + 1) {
+      const double total = std::accumulate(prior.begin(), prior.end(), 0.0);
+      if (total <= 0.0)
+        return false;
+      for (double& x : prior)
+        x /= total;
+      priors.push_back(prior);
+      prior.clear();
+    }
+  }
+  return file.eof() && prior.empty() && !priors.empty();
+}
+
+// cost(f) = c0 + round(c1 * (f / F)^p), f being a floor or a travel distance
+bool parametric_floor_costs(int F, const std::vector<double>& param, std::vector<int>& costs)
+{
+  if (param.size() != 3)
+    return false;
+  costs.assign(F + 1, 0);
+  for (int f = 1; f <= F; f++) {
+    const double cost = std::trunc(param[0]) + std::round(param[1] * std::pow(static_cast<double>(f) / F, param[2]));
+    if (!(cost >= 0.0 && cost < INT_MAX / 4))
+      return false;
+    costs[f] = static_cast<int>(cost);
+  }
+  return true;
+}
+
+// The int value tables use INT_MAX / 4 as infinity, so every path of at most F drops must stay below it
+bool costs_fit_tables(int F)
+{
+  const int max_floor = (tState::floor_cost.empty() ? 1 : *std::max_element(tState::floor_cost.begin(), tState::floor_cost.end()));
+  const int max_travel = (tState::travel_cost.empty() ? 0 : *std::max_element(tState::travel_cost.begin(), tState::travel_cost.end()));
+  return static_cast<long long>(F) * (static_cast<long long>(max_floor) + max_travel) < INT_MAX / 4;
+}
+
+std::string histogram_to_string(const std::unordered_map<int, int>& H, int kmin, int kmax) {
+  std::string s = "";
+  for (int k = kmin; k <= kmax; k++) {
+    const auto search = H.find(k);
+    if (search == H.end())
+      s += "0 ";
+    else
+      s += std::to_string(search->second) + " ";
+  }
+  return s;
+}
+
+int as_integer(const char* str) {
+  return static_cast<int>(std::strtol(str, nullptr, 0));
+}
+
+// Match an option of the form --name=value
+bool option_value(const std::string& arg, const std::string& name, std::string& value) {
+  if (arg.compare(0, name.size() + 1, name + "=") != 0)
+    return false;
+  value = arg.substr(name.size() + 1);
+  return true;
+}
+
+// Parse a comma separated list of numbers
+bool parse_list(const std::string& str, std::vector<double>& x) {
+  x.clear();
+  std::stringstream ss(str);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    char* end = nullptr;
+    x.push_back(std::strtod(item.c_str(), &end));
+    if (end == item.c_str() || *end != '\0')
+      return false;
+  }
+  return (x.size() > 0);
+}
+
+std::string padded(const std::string& s, size_t n) {
+  return (s.size() >= n ? s : s + std::string(n - s.size(), ' '));
+}
+
+void print_monte_carlo(const std::string& label, const tMonteCarlo& mc)
+{
+  const double mean = static_cast<double>(mc.sum_drops) / mc.trials;
+  const double var = static_cast<double>(mc.sum_drops_squared) / mc.trials - mean * mean;
+  std::cout << label << ": mean drops = " << mean 
+            << " (+/- " << std::sqrt(std::max(var, 0.0) / mc.trials) << "), max drops = " << mc.max_drops
+            << ", localized = " << static_cast<double>(mc.localized) / mc.trials << std::endl;
+  std::cout << label << ": drops histg. = " << histogram_to_string(mc.H, 0, mc.max_drops) << std::endl;
+}
+
+// Report for parallel droppers, in the layout of print_report (rounds instead of drops)
+int print_rounds_report(int F, int E, int k)
+{
+  std::vector<std::vector<long long>> N;
+  rounds_capacity(F, E, k, N);
+
+  for (int e = 1; e <= E; e++) {
+    std::unordered_map<int, int> histo;
+    int max_rounds = 0;
+    long long sum_rounds = 0;
+    long long sum_drops = 0;
+    long long sum_broken = 0;
+    for (int l = 0; l <= F; l++) {
+      int drops = 0;
+      int broken = 0;
+      const int rounds = run_rounds_once(F, e, l, k, N, drops, broken);
+      if (rounds < 0) {
+        std::cout << "round policy ran out of eggs (e = " << e << ", L = " << l << ")" << std::endl;
+        return 1;
+      }
+      histo[rounds]++;
+      max_rounds = std::max(max_rounds, rounds);
+      sum_rounds += rounds;
+      sum_drops += drops;
+      sum_broken += broken;
+    }
+    if (max_rounds != rounds_needed(N, e, F + 1)) {
+      std::cout << "round policy is inconsistent (e = " << e << ")" << std::endl;
+      return 1;
+    }
+    std::vector<int> floors;
+    rounds_action(N, k, {e, 0, F + 1}, floors);
+    std::cout << "--- floors F = " << F << ", eggs E = " << e << ", droppers k = " << k << " ---" << std::endl;
+    std::cout << "min max rounds = " << max_rounds << " (optimal worst case, " 
+              << classic_dpegg_limit(F, e) << " with k = 1)" << std::endl;
+    std::cout << "mean rounds    = " << static_cast<double>(sum_rounds) / (F + 1) << " (uniform limit floor)" << std::endl;
+    std::cout << "mean drops     = " << static_cast<double>(sum_drops) / (F + 1) 
+              << ", mean broken = " << static_cast<double>(sum_broken) / (F + 1) << std::endl;
+    std::cout << "rounds histg.  = " << histogram_to_string(histo, 0, max_rounds) << std::endl;
+    std::cout << "first round:  ";
+    for (int a : floors)
+      std::cout << " " << a;
+    std::cout << std::endl;
+  }
+
+  std::cout << "--- min max rounds, E = 1.." << E << " (k = " << k << ") ---" << std::endl;
+  for (int f = 1; f <= F; f++) {
+    std::cout << "floors " << std::setw(3) << f << ": ";
+    for (int e = 1; e <= E; e++)
+      std::cout << std::setw(3) << rounds_needed(N, e, f + 1) << " ";
+    std::cout << std::endl;
+  }
+
+  std::cout << "--- optimal E = " << E << " rounds for all limit levels L ---" << std::endl;
+  for (int x = 0; x <= F; x++) {
+    std::vector<std::vector<int>> rseq;
+    int drops = 0;
+    int broken = 0;
+    const int rounds = run_rounds_once(F, E, x, k, N, drops, broken, &rseq);
+    std::cout << "L = " << std::setw(3) << x << ": ";
+    for (const auto& floors : rseq) {
+      std::cout << "{";
+      for (size_t i = 0; i < floors.size(); i++)
+        std::cout << (i == 0 ? "" : " ") << floors[i];
+      std::cout << "} ";
+    }
+    std::cout << "(" << rounds << " rounds, " << drops << " drops, " << broken << " broken)" << std::endl;
+  }
+
+  return 0;
+}
+
+// Report for the cumulative damage model side by side with the pristine model (step = 0, single level)
+int print_damage_report(int F, int E, int step, int cap)
+{
+  for (int e = 1; e <= E; e++) {
+    tDamage D = {step, cap, {}};
+    tDamage P = {0, 0, {}};
+    std::vector<int> basket(cap + 1, 0);
+    basket[0] = e;
+
+    auto clock_start = std::chrono::high_resolution_clock::now();
+    const int value = damage_value(D, basket, 0, F + 1);
+    auto clock_mid = std::chrono::high_resolution_clock::now();
+    const int pristine = damage_value(P, {e}, 0, F + 1);
+    auto clock_end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> damage_time = clock_mid - clock_start;
+    std::chrono::duration<double> pristine_time = clock_end - clock_mid;
+
+    std::cout << "--- floors F = " << F << ", eggs E = " << e << ", damage step = " << step << " (cap " << cap << ") ---" << std::endl;
+    if (value == INT_MAX) {
+      std::cout << "no policy can localize every limit floor" << std::endl;
+      continue;
+    }
+
+    std::unordered_map<int, int> histo;
+    int max_drops = 0;
+    long long sum_drops = 0;
+    for (int l = 0; l <= F; l++) {
+      const int drops = run_damage_once(F, e, l, D);
+      histo[drops]++;
+      max_drops = std::max(max_drops, drops);
+      sum_drops += drops;
+    }
+    if (max_drops != value) {
+      std::cout << "damage policy is inconsistent (e = " << e << ")" << std::endl;
+      return 1;
+    }
+
+    std::cout << "min max drops = " << value << " (pristine " << pristine << ")" << std::endl;
+    std::cout << "mean drops    = " << static_cast<double>(sum_drops) / (F + 1) << " (uniform limit floor)" << std::endl;
+    std::cout << "drops histg.  = " << histogram_to_string(histo, 0, max_drops) << std::endl;
+    std::cout << "states        = " << D.memo.size() << " multiset (" << damage_labeled_states(D) << " labeled), " 
+              << P.memo.size() << " pristine" << std::endl;
+    std::cout << "duration      = " << damage_time.count() << " s. (pristine " << pristine_time.count() << " s.)" << std::endl;
+
+    if (e == E) {
+      std::cout << "--- damage E = " << E << " executions for all limit levels L ---" << std::endl;
+      for (int x = 0; x <= F; x++) {
+        std::vector<int> aseq;
+        const int xsteps = run_damage_once(F, E, x, D, &aseq);
+        std::cout << "L = " << std::setw(3) << x << ": ";
+        for (int y : aseq)
+          std::cout << y << " ";
+        std::cout << "(" << xsteps << " steps)" << std::endl;
+      }
+    }
+  }
+  return 0;
+}
+
+// Report for three-outcome drops, next to the usual two outcomes
+int print_ternary_report(int F, int E, int c, bool keep)
+{
+  tTernary t = {c, keep, {}, {}, {}, {}};
+  tTernary b = {0, false, {}, {}, {}, {}};
+  auto clock_start = std::chrono::high_resolution_clock::now();
+  ternary_tables(F, E, t);
+  auto clock_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> clock_diff = clock_end - clock_start;
+  ternary_tables(F, E, b);
+
+  std::cout << "ternary tables solved (duration = " << clock_diff.count() << " s.)" << std::endl;
+
+  const int INF = INT_MAX / 4;
+  for (int e = 1; e <= E; e++) {
+    if (t.V[e][F + 1] >= INF) {
+      std::cout << "--- floors F = " << F << ", eggs E = " << e << ": no policy, a crack band cannot be resolved ---" << std::endl;
+      continue;
+    }
+    std::unordered_map<int, int> histo;
+    int max_drops = 0;
+    long long sum_drops = 0;
+    long long sum_binary = 0;
+    for (int l = 0; l <= F; l++) {
+      const int drops = run_ternary_once(F, e, l, t, false);
+      histo[drops]++;
+      max_drops = std::max(max_drops, drops);
+      sum_drops += drops;
+      sum_binary += run_ternary_once(F, e, l, b, false);
+    }
+    if (max_drops != t.V[e][F + 1]) {
+      std::cout << "ternary policy is inconsistent (e = " << e << ")" << std::endl;
+      return 1;
+    }
+    std::cout << "--- floors F = " << F << ", eggs E = " << e << ", crack band c = " << c
+              << ", cracked eggs " << (keep ? "kept" : "lost") << " ---" << std::endl;
+    std::cout << "min max drops = " << max_drops << " (two outcomes " << b.V[e][F + 1] << ", saves "
+              << b.V[e][F + 1] - max_drops << ")" << std::endl;
+    std::cout << "mean drops    = " << static_cast<double>(sum_drops) / (F + 1) << " (two outcomes "
+              << static_cast<double>(sum_binary) / (F + 1) << ")" << std::endl;
+    std::cout << "min mean      = " << static_cast<double>(t.T[e][F + 1]) / (F + 1) << " (two outcomes "
+              << static_cast<double>(b.T[e][F + 1]) / (F + 1) << ")" << std::endl;
+    std::cout << "drops histg.  = " << histogram_to_string(histo, 0, max_drops) << std::endl;
+  }
+
+  std::cout << "--- min max drops, E = 1.." << E << " ---" << std::endl;
+  for (int f = 1; f <= F; f++) {
+    std::cout << "floors " << std::setw(3) << f << ": ";
+    for (int e = 1; e <= E; e++)
+      std::cout << std::setw(3) << (t.V[e][f + 1] < INF ? std::to_string(t.V[e][f + 1]) : "-") << " ";
+    std::cout << std::endl;
+  }
+
+  std::cout << "--- drops saved by the crack outcome, E = 1.." << E << " ---" << std::endl;
+  for (int f = 1; f <= F; f++) {
+    std::cout << "floors " << std::setw(3) << f << ": ";
+    for (int e = 1; e <= E; e++)
+      std::cout << std::setw(3) << (t.V[e][f + 1] < INF ? std::to_string(b.V[e][f + 1] - t.V[e][f + 1]) : "-") << " ";
+    std::cout << std::endl;
+  }
+
+  if (t.V[E][F + 1] >= INF)
+    return 0;
+  std::cout << "--- optimal E = " << E << " executions for all limit levels L ---" << std::endl;
+  for (int x = 0; x <= F; x++) {
+    std::vector<int> aseq;
+    const int xsteps = run_ternary_once(F, E, x, t, false, &aseq);
+    std::cout << "L = " << std::setw(3) << x << ": ";
+    for (int y : aseq)
+      std::cout << y << " ";
+    std::cout << "(" << xsteps << " steps)" << std::endl;
+  }
+
+  return 0;
+}
+
+// Report for the liar-tolerant search, with an exhaustive check over all lie patterns for small F
+int print_liar_report(int F, int k)
+{
+  tLiar D = {k, {}};
+  const std::string start(F + 1, 0);
+  auto clock_start = std::chrono::high_resolution_clock::now();
+  const int value = liar_value(D, start);
+  auto clock_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> clock_diff = clock_end - clock_start;
+
+  std::cout << "--- floors F = " << F << ", lies k = " << k << " (eggs not limited) ---" << std::endl;
+  std::cout << "min max drops = " << value << " (volume bound " << liar_volume_bound(start, k) << ", no lies "
+            << liar_volume_bound(start, 0) << ")" << std::endl;
+  std::cout << "memo states   = " << D.memo.size() << " (duration = " << clock_diff.count() << " s.)" << std::endl;
+
+  std::vector<int> floors(F + 1);
+  for (int f = 0; f <= F; f++)
+    floors[f] = f;
+
+  if (F <= 1000) {
+    long long patterns = 0;
+    long long failures = 0;
+    std::vector<int> max_drops(k + 1, 0);
+    for (int l = 0; l <= F; l++)
+      run_liar_patterns(D, l, start, floors, 0, 0, patterns, failures, max_drops);
+    std::cout << "lie patterns  = " << patterns << " checked, " << failures << " failed" << std::endl;
+    std::cout << "max drops     = ";
+    for (int j = 0; j <= k; j++)
+      std::cout << max_drops[j] << (j < k ? " " : " (by number of lies told)");
+    std::cout << std::endl;
+    if (failures > 0 || *std::max_element(max_drops.begin(), max_drops.end()) != value) {
+      std::cout << "liar policy is inconsistent" << std::endl;
+      return 1;
+    }
+  } else {
+    std::cout << "lie patterns not enumerated for F > 1000" << std::endl;
+  }
+
+  std::cout << "--- truthful executions for all limit levels L ---" << std::endl;
+  for (int l = 0; l <= F; l++) {
+    std::string s = start;
+    std::vector<int> cand = floors;
+    std::cout << "L = " << std::setw(3) << l << ": ";
+    int steps = 0;
+    while (s.size() > 1) {
+      const int t = liar_split(D, s);
+      const int a = cand[t];
+      const bool broke = (l < a);
+      std::vector<int> next_cand;
+      for (int i = 0; i < static_cast<int>(s.size()); i++)
+        if (s[i] + ((i < t) != broke ? 1 : 0) <= k)
+          next_cand.push_back(cand[i]);
+      std::string next;
+      liar_answer(s, t, broke, k, next);
+      s.swap(next);
+      cand.swap(next_cand);
+      std::cout << a << " ";
+      steps++;
+    }
+    std::cout << "(" << steps << " steps)" << std::endl;
+  }
+
+  return 0;
+}
+
+// Report for delayed feedback with lag p, next to immediate feedback (p = 0)
+int print_pipeline_report(int F, int E, int p, int nthreads)
+{
+  tPipeline P = {F, E, p, {}, 0, {}, {}};
+  tPipeline P0 = {F, E, 0, {}, 0, {}, {}};
+  auto clock_start = std::chrono::high_resolution_clock::now();
+  const int sweeps = pipeline_solve(P, nthreads);
+  auto clock_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> clock_diff = clock_end - clock_start;
+  pipeline_solve(P0, nthreads);
+
+  const int INF = INT_MAX / 4;
+  std::vector<int> start(p, 0);
+  const int value = P.V[P.index(E, F + 1, start.data())];
+  const int value0 = P0.V[P0.index(E, F + 1, nullptr)];
+
+  std::cout << "--- floors F = " << F << ", eggs E = " << E << ", feedback lag p = " << p << " ---" << std::endl;
+  std::cout << "states        = " << P.V.size() << " (" << sweeps << " block sweeps, duration = "
+            << clock_diff.count() << " s.)" << std::endl;
+  if (value >= INF) {
+    std::cout << "no policy" << std::endl;
+    return 1;
+  }
+
+  std::unordered_map<int, int> histo;
+  int max_slots = 0;
+  int max_drops = 0;
+  long long sum_slots = 0;
+  long long sum_drops = 0;
+  for (int l = 0; l <= F; l++) {
+    int drops;
+    const int slots = run_pipeline_once(P, l, drops);
+    histo[slots]++;
+    max_slots = std::max(max_slots, slots);
+    max_drops = std::max(max_drops, drops);
+    sum_slots += slots;
+    sum_drops += drops;
+  }
+  if (max_slots != value) {
+    std::cout << "pipelined policy is inconsistent" << std::endl;
+    return 1;
+  }
+
+  std::cout << "min max slots = " << value << " (p = 0: " << value0 << ", waiting for every result: "
+            << (p + 1) * value0 << ")" << std::endl;
+  std::cout << "max drops     = " << max_drops << std::endl;
+  std::cout << "mean slots    = " << static_cast<double>(sum_slots) / (F + 1) << ", mean drops = "
+            << static_cast<double>(sum_drops) / (F + 1) << std::endl;
+  std::cout << "slots histg.  = " << histogram_to_string(histo, 0, max_slots) << std::endl;
+
+  std::cout << "--- optimal E = " << E << " executions for all limit levels L (- idles) ---" << std::endl;
+  for (int x = 0; x <= F; x++) {
+    std::vector<int> aseq;
+    int drops;
+    const int xsteps = run_pipeline_once(P, x, drops, &aseq);
+    std::cout << "L = " << std::setw(3) << x << ": ";
+    for (int y : aseq) {
+      if (y < 0)
+        std::cout << "- ";
+      else
+        std::cout << y << " ";
+    }
+    std::cout << "(" << xsteps << " steps)" << std::endl;
+  }
+
+  return 0;
+}
+
+// Report the best r-stage schedules for r = 1..R (r = 1 is non-adaptive) next to the adaptive optimum
+int print_stages_report(int F, int E, int R)
+{
+  tStages S = {F, E, R, {}};
+  auto clock_start = std::chrono::high_resolution_clock::now();
+  stages_capacity(S);
+  auto clock_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> clock_diff = clock_end - clock_start;
+
+  std::map<std::pair<int, long long>, long long> memo;
+  std::cout << "capacities solved (duration = " << clock_diff.count() << " s.)" << std::endl;
+  std::vector<std::vector<long long>> N;
+  rounds_capacity(F, E, E, N);  // a stage without drop budget is a round of up to e droppers
+  std::cout << "--- adaptive: min max drops = " << bounded_drops(E, F + 1) << ", mean drops = "
+            << static_cast<double>(bounded_sum(E, F + 1, memo)) / (F + 1) << ", fewest stages = "
+            << rounds_needed(N, E, F + 1) << " ---" << std::endl;
+
+  int best_r = 0;
+  int best_D = -1;
+  for (int r = 1; r <= R; r++) {
+    int D = 0;
+    while (D <= F && S.at(r, E, D) < F + 1)
+      D++;
+    if (D > F) {
+      std::cout << "--- stages r = " << r << ": no schedule with E = " << E << " eggs ---" << std::endl;
+      continue;
+    }
+    std::unordered_map<int, int> histo;
+    int max_drops = 0;
+    long long sum_drops = 0;
+    for (int l = 0; l <= F; l++) {
+      const int drops = run_stages_once(S, r, D, l);
+      histo[drops]++;
+      max_drops = std::max(max_drops, drops);
+      sum_drops += drops;
+    }
+    if (max_drops != D) {
+      std::cout << "stage schedule is inconsistent (r = " << r << ")" << std::endl;
+      return 1;
+    }
+    std::vector<int> floors;
+    stage_floors(S, r, E, D, 0, F + 1, floors);
+    std::cout << "--- stages r = " << r << (r == 1 ? " (non-adaptive)" : "") << ", eggs E = " << E << " ---" << std::endl;
+    std::cout << "min max drops = " << D << std::endl;
+    std::cout << "mean drops    = " << static_cast<double>(sum_drops) / (F + 1) << std::endl;
+    std::cout << "drops histg.  = " << histogram_to_string(histo, 0, max_drops) << std::endl;
+    std::cout << "first stage:  ";
+    for (int a : floors)
+      std::cout << " " << a;
+    std::cout << std::endl;
+    best_r = r;
+    best_D = D;
+  }
+
+  if (best_D < 0)
+    return 0;
+  std::cout << "--- r = " << best_r << " stage schedules for all limit levels L ---" << std::endl;
+  for (int x = 0; x <= F; x++) {
+    std::vector<std::vector<int>> sseq;
+    const int drops = run_stages_once(S, best_r, best_D, x, &sseq);
+    std::cout << "L = " << std::setw(3) << x << ": ";
+    for (const auto& floors : sseq) {
+      std::cout << "{";
+      for (size_t i = 0; i < floors.size(); i++)
+        std::cout << (i > 0 ? " " : "") << floors[i];
+      std::cout << "} ";
+    }
+    std::cout << "(" << drops << " drops)" << std::endl;
+  }
+
+  return 0;
+}
+
+// Report for the economic objective; with a sweep range the summed cost is traced over egg costs in
+// [sweep_lo, sweep_hi]. A fixed policy costs drops + egg_cost broken (+ buy_cost bought), a line in
+// egg_cost, so the optimum is their lower envelope: it is solved at both ends and at the crossing of
+// the two lines found there, and new lines are split further (Eisner-Severance), so only the
+// breakpoints are re-solved rather than a grid of ratios.
+int print_economic_report(int F, int E, double egg_cost, double buy_cost, double sweep_lo, double sweep_hi)
+{
+  auto summarize = [&](const tEconomic& C, bool mean_policy, double& max_cost, double& sum_cost,
+                       long long& sum_drops, long long& sum_broken, long long& sum_bought) {
+    max_cost = sum_cost = 0.0;
+    sum_drops = sum_broken = sum_bought = 0;
+    for (int l = 0; l <= F; l++) {
+      int drops, broken, bought;
+      const double cost = run_economic_once(C, l, mean_policy, drops, broken, bought);
+      max_cost = std::max(max_cost, cost);
+      sum_cost += cost;
+      sum_drops += drops;
+      sum_broken += broken;
+      sum_bought += bought;
+    }
+  };
+
+  tEconomic C = {F, E, egg_cost, buy_cost, {}, {}, {}, {}};
+  tEconomic C0 = {F, E, 0.0, buy_cost, {}, {}, {}, {}};
+  auto clock_start = std::chrono::high_resolution_clock::now();
+  economic_tables(C);
+  auto clock_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> clock_diff = clock_end - clock_start;
+  economic_tables(C0);
+  C0.egg_cost = egg_cost;  // evaluate the drops-only policies at the actual egg cost
+
+  std::cout << "economic tables solved (duration = " << clock_diff.count() << " s.)" << std::endl;
+  std::cout << "--- floors F = " << F << ", eggs E = " << E << ", egg cost " << egg_cost << " (drop cost 1)";
+  if (buy_cost >= 0.0)
+    std::cout << ", extra eggs at " << buy_cost;
+  std::cout << " ---" << std::endl;
+  if (C.V[E][F + 1] == std::numeric_limits<double>::infinity()) {
+    std::cout << "no policy" << std::endl;
+    return 1;
+  }
+
+  const char* labels[4] = {"minimax policy  ", "mean policy     ", "drops-only max  ", "drops-only mean "};
+  for (int k = 0; k < 4; k++) {
+    double max_cost, sum_cost;
+    long long sum_drops, sum_broken, sum_bought;
+    summarize(k < 2 ? C : C0, k % 2 == 1, max_cost, sum_cost, sum_drops, sum_broken, sum_bought);
+    if ((k == 0 && std::fabs(max_cost - C.V[E][F + 1]) > 1e-6) || (k == 1 && std::fabs(sum_cost - C.T[E][F + 1]) > 1e-6)) {
+      std::cout << "economic policy is inconsistent" << std::endl;
+      return 1;
+    }
+    std::cout << labels[k] << ": max cost " << max_cost << ", mean cost " << sum_cost / (F + 1) << ", mean drops "
+              << static_cast<double>(sum_drops) / (F + 1) << ", mean broken " << static_cast<double>(sum_broken) / (F + 1);
+    if (buy_cost >= 0.0)
+      std::cout << ", mean bought " << static_cast<double>(sum_bought) / (F + 1);
+    std::cout << std::endl;
+  }
+
+  if (sweep_lo < 0.0)
+    return 0;
+
+  // line of the summed cost optimum at egg cost c: (cost without eggs, broken eggs)
+  int solves = 0;
+  auto solve_line = [&](double c) {
+    tEconomic S = {F, E, c, buy_cost, {}, {}, {}, {}};
+    economic_tables(S);
+    solves++;
+    double max_cost, sum_cost;
+    long long sum_drops, sum_broken, sum_bought;
+    summarize(S, true, max_cost, sum_cost, sum_drops, sum_broken, sum_bought);
+    return std::make_pair(sum_cost - c * sum_broken, static_cast<double>(sum_broken));
+  };
+
+  std::map<double, std::pair<double, double>> lines;  // egg cost where the line was found -> line
+  std::vector<std::pair<double, double>> todo = {{sweep_lo, sweep_hi}};
+  lines[sweep_lo] = solve_line(sweep_lo);
+  lines[sweep_hi] = solve_line(sweep_hi);
+  while (!todo.empty()) {
+    const double lo = todo.back().first;
+    const double hi = todo.back().second;
+    todo.pop_back();
+    const auto a = lines[lo];
+    const auto b = lines[hi];
+    if (a.second - b.second < 0.5)
+      continue;  // same number of broken eggs: one line covers [lo, hi]
+    const double c = (b.first - a.first) / (a.second - b.second);
+    const auto m = solve_line(c);
+    if (m.first + c * m.second < a.first + c * a.second - 1e-9) {
+      lines[c] = m;
+      todo.push_back({lo, c});
+      todo.push_back({c, hi});
+    }
+  }
+
+  std::cout << "--- mean cost optimum for egg costs in [" << sweep_lo << ", " << sweep_hi << "] (" << solves
+            << " solves) ---" << std::endl;
+  std::vector<std::pair<double, double>> envelope;
+  for (const auto& l : lines) {
+    if (envelope.empty() || envelope.back() != l.second)
+      envelope.push_back(l.second);
+  }
+  double from = sweep_lo;
+  for (size_t i = 0; i < envelope.size(); i++) {
+    double to = sweep_hi;
+    if (i + 1 < envelope.size() && envelope[i].second > envelope[i + 1].second)
+      to = (envelope[i + 1].first - envelope[i].first) / (envelope[i].second - envelope[i + 1].second);
+    if (to <= from)
+      continue;  // optimal only at a single egg cost (a tie at an end of the range)
+    std::cout << "egg cost " << std::setw(10) << from << " .. " << std::setw(10) << to << ": mean drops + bought "
+              << envelope[i].first / (F + 1) << ", mean broken " << envelope[i].second / (F + 1) << std::endl;
+    from = to;
+  }
+
+  return 0;
+}
+
+// Report for the 2D threshold search on the (F + 1) x (A + 1) grid of candidate thresholds
+int print_grid_report(int F, int A, int E, int nthreads)
+{
+  tGrid2D G = {F, A, E, 0, 0, {}, 0, {}, {}};
+  auto clock_start = std::chrono::high_resolution_clock::now();
+  if (!grid_solve(G, nthreads)) {
+    std::cout << "the 2D tables of " << G.per_level << " staircases per egg level (" << G.levels + 1 << " levels) exceed "
+              << (GRID_MAX_BYTES >> 20) << " MB" << std::endl;
+    return 1;
+  }
+  auto clock_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> clock_diff = clock_end - clock_start;
+
+  const int INF = INT_MAX / 4;
+  long long solved = 0;
+  for (int v : G.V)
+    solved += (v < INF ? 1 : 0);
+  std::cout << "2D tables solved (" << solved << " canonical states, " << G.levels << " egg levels, duration = " << clock_diff.count() << " s.)" << std::endl;
+
+  std::vector<int> full(G.M, 0);
+  std::fill(full.begin(), full.begin() + F + 1, A + 1);
+  bool mirrored;
+  const long long root = grid_canonical(G, full.data(), mirrored);
+  for (int e = 1; e <= E; e++) {
+    const int value = G.V[G.index(e, root)];
+    std::cout << "--- floors F = " << F << ", angles A = " << A << ", eggs E = " << e << " ---" << std::endl;
+    if (value >= INF) {
+      std::cout << "no policy" << std::endl;
+      continue;
+    }
+    std::unordered_map<int, int> histo;
+    int max_drops = 0;
+    long long sum_drops = 0;
+    for (int tx = 0; tx <= F; tx++) {
+      for (int ty = 0; ty <= A; ty++) {
+        const int drops = run_grid_once(G, e, tx, ty);
+        histo[drops]++;
+        max_drops = std::max(max_drops, drops);
+        sum_drops += drops;
+      }
+    }
+    if (max_drops != value) {
+      std::cout << "2D policy is inconsistent (e = " << e << ")" << std::endl;
+      return 1;
+    }
+    std::vector<std::pair<int, int>> pseq;
+    run_grid_once(G, e, F, A, &pseq);
+    std::cout << "min max drops = " << max_drops << " (optimal worst case)" << std::endl;
+    std::cout << "mean drops    = " << static_cast<double>(sum_drops) / ((F + 1) * (A + 1)) << " (uniform threshold)" << std::endl;
+    std::cout << "drops histg.  = " << histogram_to_string(histo, 0, max_drops) << std::endl;
+    std::cout << "first probe   = (" << pseq[0].first << ", " << pseq[0].second << ")" << std::endl;
+  }
+
+  std::cout << "--- optimal E = " << E << " executions for all thresholds (L, angle) ---" << std::endl;
+  if (G.V[G.index(E, root)] >= INF)
+    return 0;
+  for (int tx = 0; tx <= F; tx++) {
+    for (int ty = 0; ty <= A; ty++) {
+      std::vector<std::pair<int, int>> pseq;
+      const int drops = run_grid_once(G, E, tx, ty, &pseq);
+      std::cout << "L = " << std::setw(3) << tx << ", " << std::setw(3) << ty << ": ";
+      for (const auto& p : pseq)
+        std::cout << "(" << p.first << "," << p.second << ") ";
+      std::cout << "(" << drops << " steps)" << std::endl;
+    }
+  }
+
+  return 0;
+}
+
+// Report for one poset (chain, grid or tree); a chain is checked against single_scan
+int print_poset_report(const std::string& name, tPoset& P, int E, int chain_floors)
+{
+  std::unordered_map<tState, int> V, A;
+  if (chain_floors > 0) {
+    initialize_terminal_nodes(chain_floors, E, V);
+    for (int e = 1; e <= E; e++) {
+      int inserts = 1;
+      int modifies = 1;
+      while (inserts > 0 || modifies > 0) {
+        inserts = modifies = 0;
+        single_scan(chain_floors, e, e, V, A, inserts, modifies, false, false, false);
+      }
+    }
+  }
+
+  const uint64_t all = (P.n == 64 ? ~0ULL : (1ULL << P.n) - 1);
+  P.memo.assign(E + 1, {});
+  for (int e = 1; e <= E; e++) {
+    auto clock_start = std::chrono::high_resolution_clock::now();
+    const int value = poset_value(P, e, all);
+    auto clock_end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> clock_diff = clock_end - clock_start;
+    size_t states = 0;
+    for (const auto& m : P.memo)
+      states += m.size();
+    std::cout << "--- " << name << ", n = " << P.n << " configurations, eggs E = " << e << " ---" << std::endl;
+    if (value >= INT_MAX / 4) {
+      std::cout << "no policy" << std::endl;
+      continue;
+    }
+    std::cout << "min max drops = " << value << " (first probe " << P.memo[e][all].second << ")" << std::endl;
+    std::cout << "memo states   = " << states << " (duration = " << clock_diff.count() << " s.)" << std::endl;
+    if (chain_floors > 0) {
+      const int scan_value = V.at({e, 0, chain_floors + 1, 0});
+      std::cout << "single_scan   = " << scan_value << std::endl;
+      if (scan_value != value) {
+        std::cout << "poset solver is inconsistent with single_scan" << std::endl;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+// Posets of F configurations: "chain", "grid,A" (F x A product of chains), "tree,k" (k-ary tree in BFS
+// order, the root lowest); "bench" runs a chain, a grid and a binary tree of about F configurations.
+int run_poset(const std::string& spec, int F, int E)
+{
+  std::vector<double> param;
+  const size_t comma = spec.find(',');
+  const std::string kind = spec.substr(0, comma);
+  if (comma != std::string::npos && !parse_list(spec.substr(comma + 1), param))
+    return -1;
+
+  auto chain = [](int n) {
+    std::vector<std::pair<int, int>> edges;
+    for (int x = 0; x + 1 < n; x++)
+      edges.push_back({x, x + 1});
+    return edges;
+  };
+  auto grid = [](int a, int b) {
+    std::vector<std::pair<int, int>> edges;
+    for (int x = 0; x < a; x++) {
+      for (int y = 0; y < b; y++) {
+        if (x + 1 < a)
+          edges.push_back({x * b + y, (x + 1) * b + y});
+        if (y + 1 < b)
+          edges.push_back({x * b + y, x * b + y + 1});
+      }
+    }
+    return edges;
+  };
+  auto tree = [](int n, int k) {
+    std::vector<std::pair<int, int>> edges;
+    for (int x = 1; x < n; x++)
+      edges.push_back({(x - 1) / k, x});
+    return edges;
+  };
+
+  tPoset P;
+  if (kind == "chain" && param.empty() && F <= 64) {
+    poset_from_edges(P, F, chain(F));
+    return print_poset_report("chain", P, E, F);
+  }
+  if (kind == "grid" && param.size() == 1 && param[0] >= 1 && F * param[0] <= 64) {
+    const int a = static_cast<int>(param[0]);
+    poset_from_edges(P, F * a, grid(F, a));
+    return print_poset_report("grid " + std::to_string(F) + " x " + std::to_string(a), P, E, 0);
+  }
+  if (kind == "tree" && param.size() == 1 && param[0] >= 1 && F <= 64) {
+    const int k = static_cast<int>(param[0]);
+    poset_from_edges(P, F, tree(F, k));
+    return print_poset_report(std::to_string(k) + "-ary tree", P, E, 0);
+  }
+  if (kind == "bench" && param.empty() && F <= 64) {
+    int a = 1;
+    while ((a + 1) * (a + 1) <= F)
+      a++;
+    poset_from_edges(P, F, chain(F));
+    int result = print_poset_report("chain", P, E, F);
+    poset_from_edges(P, a * a, grid(a, a));
+    result |= print_poset_report("grid " + std::to_string(a) + " x " + std::to_string(a), P, E, 0);
+    poset_from_edges(P, F, tree(F, 2));
+    result |= print_poset_report("2-ary tree", P, E, 0);
+    return result;
+  }
+  return -1;
+}
+
+// Report for a shared egg budget over several buildings
+int print_buildings_report(const std::vector<int>& floors, int E)
+{
+  const int k = static_cast<int>(floors.size());
+  std::vector<std::vector<int>> tables;
+  for (int i = 0; i < k; i++) {
+    tables.push_back(building_table(floors[i], E));
+    std::cout << "building " << i + 1 << ": F = " << floors[i] << ", drops for e = 1.." << E << ":";
+    for (int e = 1; e <= E; e++)
+      std::cout << " " << (tables[i][e] >= INT_MAX / 4 ? std::string("-") : std::to_string(tables[i][e]));
+    std::cout << std::endl;
+  }
+
+  auto print_allocation = [](const std::vector<int>& allocation) {
+    std::string text;
+    for (size_t i = 0; i < allocation.size(); i++)
+      text += (i > 0 ? "," : "") + std::to_string(allocation[i]);
+    return text;
+  };
+
+  std::vector<int> allocation;
+  const int static_total = allocate_eggs(tables, E, false, allocation);
+  if (static_total >= INT_MAX / 4) {
+    std::cout << "no policy: " << E << " eggs cannot cover " << k << " buildings" << std::endl;
+    return 0;
+  }
+  std::cout << "static allocation, min total drops = " << static_total << " (eggs " << print_allocation(allocation) << ")" << std::endl;
+  const int static_max = allocate_eggs(tables, E, true, allocation);
+  std::cout << "static allocation, min max drops   = " << static_max << " (eggs " << print_allocation(allocation) << ")" << std::endl;
+
+  // Carried-over eggs: the given order, and the best order for a few buildings
+  std::vector<int> order(k);
+  std::iota(order.begin(), order.end(), 0);
+  int first_drop = 0;
+  auto clock_start = std::chrono::high_resolution_clock::now();
+  const int carry_total = carry_over_total(floors, order, E, first_drop);
+  auto clock_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> clock_diff = clock_end - clock_start;
+  std::cout << "carried-over eggs, min total drops = " << carry_total << " (given order, first drop at floor " << first_drop << ", duration = " << clock_diff.count() << " s.)" << std::endl;
+  if (carry_total > static_total) {
+    std::cout << "carried-over search is worse than the static allocation" << std::endl;
+    return 1;
+  }
+  if (k <= 6) {
+    std::vector<int> best_order = order;
+    int best_total = carry_total;
+    while (std::next_permutation(order.begin(), order.end())) {
+      const int total = carry_over_total(floors, order, E, first_drop);
+      if (total < best_total) {
+        best_total = total;
+        best_order = order;
+      }
+    }
+    std::string text;
+    for (int i = 0; i < k; i++)
+      text += (i > 0 ? "," : "") + std::to_string(best_order[i] + 1);
+    std::cout << "carried-over eggs, min total drops = " << best_total << " (best order " << text << ")" << std::endl;
+  }
+  return 0;
+}
+
+// Report for the p-quantile objective under the prior (uniform if empty), next to the minimax policy
+int print_quantile_report(int F, int E, double p, const std::vector<double>& prior, int nthreads)
+{
+  tQuantile Q;
+  Q.F = F;
+  Q.E = E;
+  Q.cumulative.assign(F + 2, 0.0);
+  for (int f = 0; f <= F; f++)
+    Q.cumulative[f + 1] = Q.cumulative[f] + (prior.empty() ? 1.0 / (F + 1) : prior[f]);
+
+  auto clock_start = std::chrono::high_resolution_clock::now();
+  quantile_solve(Q, nthreads);
+  auto clock_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> clock_diff = clock_end - clock_start;
+  const std::string weighting = (prior.empty() ? "uniform limit floor" : "prior");
+
+  for (int e = 1; e <= E; e++) {
+    const int cap = static_cast<int>(bounded_drops(e, F + 1LL));
+    int d = 0;
+    while (d < cap && Q.at(e, 0, F + 1, d) < p - 1e-9)
+      d++;
+
+    std::cout << "--- floors F = " << F << ", eggs E = " << e << ", quantile p = " << p << " ---" << std::endl;
+    for (int budget : {d, 0}) {
+      std::unordered_map<int, int> histo;
+      std::vector<std::pair<int, double>> outcomes;
+      int max_drops = 0;
+      double mean_drops = 0.0;
+      for (int l = 0; l <= F; l++) {
+        const int drops = run_quantile_once(Q, e, budget, l);
+        histo[drops]++;
+        max_drops = std::max(max_drops, drops);
+        mean_drops += drops * Q.mass(l, l + 1);
+        outcomes.push_back({drops, Q.mass(l, l + 1)});
+      }
+      std::sort(outcomes.begin(), outcomes.end());
+      double reached = 0.0;
+      int quantile = 0;
+      for (const auto& outcome : outcomes) {
+        quantile = outcome.first;
+        reached += outcome.second;
+        if (reached >= p - 1e-9)
+          break;
+      }
+      std::cout << (budget == d ? "quantile policy:" : "minimax policy:") << std::endl;
+      std::cout << padded("p-quantile drops", 17) << "= " << quantile << std::endl;
+      std::cout << padded("max drops", 17) << "= " << max_drops << std::endl;
+      std::cout << padded("mean drops", 17) << "= " << mean_drops << " (" << weighting << ")" << std::endl;
+      std::cout << padded("drops histg.", 17) << "= " << histogram_to_string(histo, 0, max_drops) << std::endl;
+      if (budget == d && quantile != d) {
+        std::cout << "quantile policy is inconsistent (e = " << e << ")" << std::endl;
+        return 1;
+      }
+    }
+  }
+  std::cout << "duration = " << clock_diff.count() << " s." << std::endl;
+  return 0;
+}
+
+// Report for a fixed drop budget D: the most probable localization within D drops, and the success
+// probability versus the budget for all e from the same tables
+int print_budget_report(int F, int E, int D, const std::vector<double>& prior, int nthreads)
+{
+  tQuantile Q;
+  Q.F = F;
+  Q.E = E;
+  Q.cumulative.assign(F + 2, 0.0);
+  for (int f = 0; f <= F; f++)
+    Q.cumulative[f + 1] = Q.cumulative[f] + (prior.empty() ? 1.0 / (F + 1) : prior[f]);
+
+  auto clock_start = std::chrono::high_resolution_clock::now();
+  quantile_solve(Q, nthreads);
+  auto clock_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> clock_diff = clock_end - clock_start;
+
+  for (int e = 1; e <= E; e++) {
+    std::cout << "--- floors F = " << F << ", eggs E = " << e << ", drop budget D = " << D << " ---" << std::endl;
+    const double optimum = Q.at(e, 0, F + 1, D);
+    for (int budget : {D, 0}) {
+      double success = 0.0;
+      int max_drops = 0;
+      for (int l = 0; l <= F; l++) {
+        const int drops = run_quantile_once(Q, e, budget, l);
+        max_drops = std::max(max_drops, drops);
+        if (drops <= D)
+          success += Q.mass(l, l + 1);
+      }
+      std::cout << padded(budget == D ? "budget policy" : "minimax policy", 15) << ": success = " << success << ", max drops = " << max_drops << std::endl;
+      if (budget == D && std::fabs(success - optimum) > 1e-9) {
+        std::cout << "budget policy is inconsistent (e = " << e << ")" << std::endl;
+        return 1;
+      }
+    }
+  }
+
+  const int rows = (E >= 2 ? Q.len[2][F + 1] : F);
+  std::cout << "--- success probability vs drop budget, E = 1.." << E << " ---" << std::endl;
+  for (int d = 0; d <= rows; d++) {
+    std::cout << "D = " << std::setw(3) << d << ": ";
+    for (int e = 1; e <= E; e++)
+      std::cout << std::setw(8) << Q.at(e, 0, F + 1, d) << " ";
+    std::cout << std::endl;
+  }
+  std::cout << "duration = " << clock_diff.count() << " s." << std::endl;
+  return 0;
+}
+
+// Minimax drops of the root for tolerances 0..k from the reach recursion, with the drops saved per unit of
+// tolerance (unit costs without forbidden floors only); the solved root value V must agree
+template <typename TV>
+int print_tolerance_savings(int F, int E, const TV& V)
+{
+  const int k = tState::tolerance;
+  if (!tState::floor_cost.empty() || !tState::travel_cost.empty() || !tState::allowed_floor.empty())
+    return 0;
+  std::cout << "--- drops saved by tolerance 0.." << k << ", E = 1.." << E << " ---" << std::endl;
+  for (int e = 1; e <= E; e++) {
+    const long long exact = tolerant_drops(e, F + 1LL, 0);
+    std::cout << "eggs " << std::setw(3) << e << ": ";
+    for (int t = 0; t <= k; t++)
+      std::cout << std::setw(3) << tolerant_drops(e, F + 1LL, t) << " ";
+    std::cout << "(saved " << exact - tolerant_drops(e, F + 1LL, k) << ", "
+              << static_cast<double>(exact - tolerant_drops(e, F + 1LL, k)) / k << " per floor of tolerance)" << std::endl;
+    int value = 0;
+    table_find(V, {e, 0, F + 1}, value);
+    if (value != tolerant_drops(e, F + 1LL, k)) {
+      std::cout << "tolerant solution is inconsistent with the reach recursion (e = " << e << ")" << std::endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Report for an incremental re-solve after a prior update, checked against a full re-solve
+int print_prior_update_report(int F, int E, const std::vector<double>& prior,
+                              const std::vector<std::pair<int, double>>& delta, int nthreads)
+{
+  tPriorTables T;
+  T.F = F;
+  T.E = E;
+  T.weight = (prior.empty() ? std::vector<double>(F + 1, 1.0 / (F + 1)) : prior);
+
+  auto clock_start = std::chrono::high_resolution_clock::now();
+  prior_solve(T, nthreads);
+  auto clock_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> full_diff = clock_end - clock_start;
+
+  std::vector<double> before(E + 1);
+  for (int e = 1; e <= E; e++)
+    before[e] = T.P.at(e, 0, F + 1) / T.W.at(1, 0, F + 1);
+
+  long long changed = 0;
+  clock_start = std::chrono::high_resolution_clock::now();
+  const long long resolved = prior_update(T, delta, nthreads, changed);
+  clock_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> update_diff = clock_end - clock_start;
+
+  tPriorTables R;
+  R.F = F;
+  R.E = E;
+  R.weight = T.weight;
+  prior_solve(R, nthreads);
+
+  const long long states = static_cast<long long>(T.P.size());
+  std::cout << "--- floors F = " << F << ", eggs E = " << E << ", prior update of " << delta.size() << " floors ---" << std::endl;
+  std::cout << "full solve        : " << states << " states (duration = " << full_diff.count() << " s.)" << std::endl;
+  std::cout << "incremental solve : " << resolved << " states re-solved (" << 100.0 * resolved / states
+            << "%), " << changed << " actions changed (duration = " << update_diff.count() << " s.)" << std::endl;
+  for (int e = 1; e <= E; e++)
+    std::cout << "eggs " << std::setw(3) << e << ": expected drops " << before[e] << " -> " << T.P.at(e, 0, F + 1) / T.W.at(1, 0, F + 1) << std::endl;
+  if (T.P.data != R.P.data || T.A.data != R.A.data) {
+    std::cout << "incremental solve is inconsistent with the full re-solve" << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+// Report for K priors solved in one batch, timed against K separate solves and checked lane by lane
+int print_prior_batch_report(int F, int E, const std::vector<std::vector<double>>& priors, int nthreads)
+{
+  tPriorBatch B;
+  B.F = F;
+  B.E = E;
+  const int K = static_cast<int>(priors.size());
+  B.K = (K + PRIOR_LANES - 1) / PRIOR_LANES * PRIOR_LANES;
+  B.weight.assign(static_cast<size_t>(F + 1) * B.K, 0.0);
+  for (int k = 0; k < K; k++) {
+    for (int f = 0; f <= F; f++)
+      B.weight[static_cast<size_t>(f) * B.K + k] = priors[k][f];
+  }
+
+  auto clock_start = std::chrono::high_resolution_clock::now();
+  prior_batch_solve(B, nthreads);
+  auto clock_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> batch_diff = clock_end - clock_start;
+
+  std::cout << "--- floors F = " << F << ", eggs E = " << E << ", " << K << " priors ---" << std::endl;
+  std::chrono::duration<double> single_diff(0.0);
+  bool consistent = true;
+  for (int k = 0; k < K; k++) {
+    tPriorTables T;
+    T.F = F;
+    T.E = E;
+    T.weight = priors[k];
+    clock_start = std::chrono::high_resolution_clock::now();
+    prior_solve(T, nthreads);
+    clock_end = std::chrono::high_resolution_clock::now();
+    single_diff += clock_end - clock_start;
+    for (int e = 1; e <= E; e++) {
+      for (int w = 1; w <= F + 1; w++) {
+        for (int lb = 0; lb + w <= F + 1; lb++) {
+          const size_t i = B.index(e, lb, lb + w) + k;
+          consistent = consistent && B.P[i] == T.P.at(e, lb, lb + w) && B.A[i] == T.A.at(e, lb, lb + w);
+        }
+      }
+    }
+    std::cout << "prior " << std::setw(3) << k + 1 << ": expected drops E = 1.." << E << ":";
+    for (int e = 1; e <= E; e++)
+      std::cout << " " << B.P[B.index(e, 0, F + 1) + k];
+    std::cout << " (first drop " << B.A[B.index(E, 0, F + 1) + k] << ")" << std::endl;
+  }
+  std::cout << "batched solve  : duration = " << batch_diff.count() << " s." << std::endl;
+  std::cout << "separate solves: duration = " << single_diff.count() << " s. (speedup " << single_diff.count() / batch_diff.count() << ")" << std::endl;
+  if (!consistent) {
+    std::cout << "batched solve is inconsistent with the separate solves" << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+// Tie regret map of the solved dense tables: a per-level summary, and the binary file
+//   "DPTR", int32 F, int32 E, then one int32 regret (saturated) per state in tDense::index order
+// i.e. by level e = 1..E, width w = 1..F+1, lb = 0..F+1-w.
+int print_tie_regret_report(int F, int E, const tDenseConfig& cfg, const tDense<int>& V,
+                            const tDense<long long>& S, const std::string& filename)
+{
+  std::vector<int32_t> regret(V.size(), 0);
+  std::vector<int32_t> ties(V.size(), 0);
+  auto clock_start = std::chrono::high_resolution_clock::now();
+  for (int e = 1; e <= E; e++) {
+    for (int w = 2; w <= F + 1; w++) {
+      parallel_for(0, F + 2 - w, cfg.nthreads, [&](int b, int end) {
+        for (int lb = b; lb < end; lb++) {
+          int count = 0;
+          const long long r = tie_regret_state(e, lb, lb + w, cfg, V, S, count);
+          regret[V.index(e, lb, lb + w)] = static_cast<int32_t>(std::min<long long>(r, INT32_MAX));
+          ties[V.index(e, lb, lb + w)] = count;
+        }
+      });
+    }
+  }
+  auto clock_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> clock_diff = clock_end - clock_start;
+
+  for (int e = 1; e <= E; e++) {
+    long long tied = 0;
+    long long matters = 0;
+    int32_t worst = 0;
+    tState worst_state = {e, 0, 1};
+    for (int w = 2; w <= F + 1; w++) {
+      for (int lb = 0; lb + w <= F + 1; lb++) {
+        const size_t i = V.index(e, lb, lb + w);
+        tied += (ties[i] > 1 ? 1 : 0);
+        matters += (regret[i] > 0 ? 1 : 0);
+        if (regret[i] > worst) {
+          worst = regret[i];
+          worst_state = {e, lb, lb + w};
+        }
+      }
+    }
+    std::cout << "--- floors F = " << F << ", eggs E = " << e << " ---" << std::endl;
+    std::cout << "tied states   = " << tied << " of " << V.per_level << ", " << matters << " with regret > 0" << std::endl;
+    std::cout << "max regret    = " << worst << " at " << worst_state << (tState::floor_cost.empty() ? " (summed drops)" : " (summed cost)") << std::endl;
+    std::cout << "root regret   = " << regret[V.index(e, 0, F + 1)] << " over " << ties[V.index(e, 0, F + 1)] << " tied drops" << std::endl;
+  }
+
+  std::ofstream file(filename, std::ios::binary);
+  const int32_t header[2] = {F, E};
+  file.write("DPTR", 4);
+  file.write(reinterpret_cast<const char*>(header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(regret.data()), regret.size() * sizeof(int32_t));
+  if (!file) {
+    std::cout << "failed to write \"" << filename << "\"" << std::endl;
+    return 1;
+  }
+  std::cout << "tie regret map written to \"" << filename << "\" (" << regret.size() << " states, duration = " << clock_diff.count() << " s.)" << std::endl;
+  return 0;
+}
+
+// Report the range of mean drops over the minimax-optimal policies for every (f, e), checked against the
+// tied policies' range and the --left / --right policies of the dense engine, with witnesses for (F, E)
+int print_mean_bounds_report(int F, int E, const tDenseConfig& cfg)
+{
+  tMeanBounds M;
+  M.F = F;
+  M.E = E;
+  auto clock_start = std::chrono::high_resolution_clock::now();
+  mean_bounds_solve(M);
+  auto clock_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> clock_diff = clock_end - clock_start;
+
+  tDenseConfig sample = cfg;
+  sample.minimize_mean = sample.use_tiebreak = sample.pick_right = false;
+  for (bool left : {true, false}) {
+    sample.pick_left = left;
+    sample.pick_right = !left;
+    tDense<int> V;
+    tDense<int> A;
+    tDense<long long> S;
+    dense_scan(F, E, sample, V, A, S);
+    for (int e = 1; e <= E; e++) {
+      for (int f = 1; f <= F; f++) {
+        const long long summed = S.at(e, 0, f + 1);
+        const int b = M.D[e][f + 1];
+        if (V.at(e, 0, f + 1) != b || summed < M.tmin(e, f + 1) || summed > M.tmax(e, f + 1) ||
+            M.tmin(e, f + 1) < M.smin(e, f + 1, b) || M.tmax(e, f + 1) > M.smax(e, f + 1, b)) {
+          std::cout << "mean bounds are inconsistent (e = " << e << ", f = " << f << ")" << std::endl;
+          return 1;
+        }
+      }
+    }
+  }
+
+  for (int e = 1; e <= E; e++) {
+    const int b = M.D[e][F + 1];
+    std::cout << "--- floors F = " << F << ", eggs E = " << e << " ---" << std::endl;
+    std::cout << "min max drops = " << b << std::endl;
+    std::cout << "mean drops    = " << static_cast<double>(M.smin(e, F + 1, b)) / (F + 1) << " .. "
+              << static_cast<double>(M.smax(e, F + 1, b)) / (F + 1) << " (all minimax-optimal policies)" << std::endl;
+    std::cout << "mean drops    = " << static_cast<double>(M.tmin(e, F + 1)) / (F + 1) << " .. "
+              << static_cast<double>(M.tmax(e, F + 1)) / (F + 1) << " (tied drops in every state)" << std::endl;
+  }
+
+  for (bool most : {false, true}) {
+    std::cout << "--- " << (most ? "max" : "min") << " mean drops over minimax-optimal policies, E = 1.." << E << " ---" << std::endl;
+    for (int f = 1; f <= F; f++) {
+      std::cout << "floors " << std::setw(3) << f << ": ";
+      for (int e = 1; e <= E; e++) {
+        const int b = M.D[e][f + 1];
+        const long long summed = (most ? M.smax(e, f + 1, b) : M.smin(e, f + 1, b));
+        std::cout << std::setw(8) << static_cast<double>(summed) / (f + 1) << " ";
+      }
+      std::cout << std::endl;
+    }
+  }
+
+  for (bool most : {false, true}) {
+    std::cout << "--- " << (most ? "max" : "min") << " mean witness E = " << E << " executions for all limit levels L ---" << std::endl;
+    long long total = 0;
+    std::vector<int> aseq;
+    for (int x = 0; x <= F; x++) {
+      const int steps = run_mean_bound_witness(M, E, F, most, x, &aseq);
+      total += steps;
+      std::cout << "L = " << std::setw(3) << x << ": ";
+      for (int y : aseq)
+        std::cout << y << " ";
+      std::cout << "(" << steps << " steps)" << std::endl;
+    }
+    const int b = M.D[E][F + 1];
+    if (total != (most ? M.smax(E, F + 1, b) : M.smin(E, F + 1, b))) {
+      std::cout << "witness policy is inconsistent" << std::endl;
+      return 1;
+    }
+  }
+  std::cout << "duration = " << clock_diff.count() << " s." << std::endl;
+  return 0;
+}
+
+// Hot-swap demo: reader threads localize random limit floors through the handle while the writer
+// publishes new policies (alternating tie rules and building heights F, F - 1) swaps times
+int print_policy_swap_report(int F, int E, int swaps, const tDenseConfig& cfg, int readers, unsigned int seed)
+{
+  readers = std::max(1, std::min(readers, RCU_MAX_READERS));
+  tDenseConfig one = cfg;
+  one.nthreads = 1;
+  tPolicyHandle handle(new tPolicy(F, E, one, 0));
+  std::atomic<bool> done{false};
+  std::vector<long long> lookups(readers, 0);
+  std::vector<long long> errors(readers, 0);
+  std::vector<int> versions_seen(readers, 0);
+
+  auto reader = [&](int r) {
+    std::mt19937 rng(seed + r);
+    int last_version = -1;
+    while (!done.load(std::memory_order_relaxed)) {
+      const tPolicy* policy = handle.enter(r);
+      const int e = 1 + static_cast<int>(rng() % policy->E);
+      const int L = static_cast<int>(rng() % (policy->F + 1));
+      const int drops = policy->run(e, L);
+      errors[r] += (drops > policy->V.at(e, 0, policy->F + 1) ? 1 : 0);
+      if (policy->version != last_version) {
+        last_version = policy->version;
+        versions_seen[r]++;
+      }
+      handle.leave(r);
+      lookups[r]++;
+    }
+  };
+
+  auto clock_start = std::chrono::high_resolution_clock::now();
+  std::vector<std::thread> workers;
+  for (int r = 0; r < readers; r++)
+    workers.emplace_back(reader, r);
+  int reclaimed = 0;
+  for (int k = 1; k <= swaps; k++) {
+    tDenseConfig next = one;
+    next.pick_left = (k % 2 == 1);
+    next.pick_right = !next.pick_left;
+    reclaimed += handle.swap(new tPolicy(k % 2 == 1 ? std::max(1, F - 1) : F, E, next, k));
+  }
+  done.store(true);
+  for (auto& worker : workers)
+    worker.join();
+  reclaimed += handle.reclaim();
+  auto clock_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> clock_diff = clock_end - clock_start;
+
+  long long total = 0;
+  long long total_errors = 0;
+  int seen = 0;
+  for (int r = 0; r < readers; r++) {
+    total += lookups[r];
+    total_errors += errors[r];
+    seen = std::max(seen, versions_seen[r]);
+  }
+  std::cout << "--- floors F = " << F << ", eggs E = " << E << ", " << swaps << " policy swaps, " << readers << " readers ---" << std::endl;
+  std::cout << "executions    = " << total << " (" << total / clock_diff.count() << " per s.)" << std::endl;
+  std::cout << "versions seen = " << seen << " (most by one reader)" << std::endl;
+  std::cout << "reclaimed     = " << reclaimed << " of " << swaps << " retired policies" << std::endl;
+  std::cout << "duration      = " << clock_diff.count() << " s." << std::endl;
+  if (total_errors > 0 || reclaimed != swaps) {
+    std::cout << "policy handle is inconsistent (" << total_errors << " executions above the minimax value)" << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+// Decision surfaces of every state up to width wmax, from the solved dense tables: for each drop floor a
+// of a state the minimax value c + max(V(e - 1, lb, a), V(e, a, ub)) and the mean
+// (w c + S(e - 1, lb, a) + S(e, a, ub)) / w, one lookup per table and candidate. The binary file is
+//   "DPDS", int32 F, E, wmax,
+//   index: per chunk (e = 1..E, w = 2..wmax) uint64 byte offset and uint64 byte size,
+//   chunks: lb = 0..F+1-w, then a = lb+1..lb+w-1: int32 value, float mean
+// with value -1 and mean NaN for forbidden floors and drops that a single egg cannot afford.
+int print_surface_report(int F, int E, int wmax, const tDenseConfig& cfg, const tDense<int>& V,
+                         const tDense<long long>& S, const std::string& filename)
+{
+  struct tCandidate {
+    int32_t value;
+    float mean;
+  };
+  static_assert(sizeof(tCandidate) == 8, "packed candidate record");
+
+  wmax = std::min(wmax, F + 1);
+  const int chunks = E * (wmax - 1);
+  std::ofstream file(filename, std::ios::binary);
+  const int32_t header[3] = {F, E, wmax};
+  file.write("DPDS", 4);
+  file.write(reinterpret_cast<const char*>(header), sizeof(header));
+  std::vector<uint64_t> index(2 * chunks, 0);
+  uint64_t offset = 4 + sizeof(header) + index.size() * sizeof(uint64_t);
+  for (int e = 1, c = 0; e <= E; e++) {
+    for (int w = 2; w <= wmax; w++, c++) {
+      index[2 * c] = offset;
+      index[2 * c + 1] = static_cast<uint64_t>(F + 2 - w) * (w - 1) * sizeof(tCandidate);
+      offset += index[2 * c + 1];
+    }
+  }
+  file.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(uint64_t));
+
+  std::vector<tCandidate> chunk;
+  std::atomic<long long> mismatches{0};
+  long long candidates = 0;
+  auto clock_start = std::chrono::high_resolution_clock::now();
+  for (int e = 1; e <= E; e++) {
+    for (int w = 2; w <= wmax; w++) {
+      chunk.assign(static_cast<size_t>(F + 2 - w) * (w - 1), {-1, std::numeric_limits<float>::quiet_NaN()});
+      parallel_for(0, F + 2 - w, cfg.nthreads, [&](int b, int end) {
+        for (int lb = b; lb < end; lb++) {
+          const int ub = lb + w;
+          const tState s = {e, lb, ub};
+          tCandidate* row = &chunk[static_cast<size_t>(lb) * (w - 1)];
+          int best = INT_MAX;
+          for (int a = tState::next_allowed(lb + 1); a < ub; a = tState::next_allowed(a + 1)) {
+            const int c = s.cost(a, lb);
+            long long summed = 0;
+            int value = 0;
+            if (e == 1) {
+              if (a > tState::next_allowed(lb + 1) && !tState({0, lb, a}).isterminal())
+                break;
+              value = c + V.at(e, a, ub);
+              summed = w * c + S.at(e, a, ub);
+            } else {
+              value = c + std::max(V.at(e - 1, lb, a), V.at(e, a, ub));
+              summed = w * c + S.at(e - 1, lb, a) + S.at(e, a, ub);
+            }
+            row[a - lb - 1] = {value, static_cast<float>(static_cast<double>(summed) / w)};
+            best = std::min(best, value);
+          }
+          if (!s.isterminal() && !cfg.minimize_mean && best != V.at(e, lb, ub))
+            mismatches++;
+        }
+      });
+      candidates += chunk.size();
+      file.write(reinterpret_cast<const char*>(chunk.data()), chunk.size() * sizeof(tCandidate));
+    }
+  }
+  auto clock_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> clock_diff = clock_end - clock_start;
+  if (!file) {
+    std::cout << "failed to write \"" << filename << "\"" << std::endl;
+    return 1;
+  }
+  std::cout << "--- decision surfaces, floors F = " << F << ", eggs E = 1.." << E << ", widths 2.." << wmax << " ---" << std::endl;
+  std::cout << "chunks        = " << chunks << " (one per egg level and width)" << std::endl;
+  std::cout << "candidates    = " << candidates << " (" << offset << " bytes)" << std::endl;
+  std::cout << "written to \"" << filename << "\" (threads = " << cfg.nthreads << ", duration = " << clock_diff.count() << " s.)" << std::endl;
+  if (mismatches > 0) {
+    std::cout << "decision surfaces are inconsistent with V in " << mismatches << " states" << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+// Report for the audit of a logged execution file, optionally generated first
+int print_audit_report(int F, int E, const tDenseConfig& cfg, const std::string& filename, long long generate,
+                       double fault, unsigned int seed)
+{
+  tDense<int> V;
+  tDense<int> A;
+  tDense<long long> S;
+  dense_scan(F, E, cfg, V, A, S);
+
+  if (generate > 0) {
+    auto clock_start = std::chrono::high_resolution_clock::now();
+    if (!generate_audit_log(filename, F, E, A, generate, fault, seed)) {
+      std::cout << "failed to write \"" << filename << "\"" << std::endl;
+      return 1;
+    }
+    auto clock_end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> clock_diff = clock_end - clock_start;
+    std::cout << "generated " << generate << " executions (fault rate " << fault << ", duration = " << clock_diff.count() << " s.)" << std::endl;
+  }
+
+  tAuditCounts counts;
+  size_t nwords = 0;
+  auto clock_start = std::chrono::high_resolution_clock::now();
+  if (!audit_log(filename, F, E, V, cfg.nthreads, counts, nwords)) {
+    std::cout << "failed to map the execution log \"" << filename << "\"" << std::endl;
+    return 1;
+  }
+  auto clock_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> clock_diff = clock_end - clock_start;
+
+  const std::string unit = (tState::floor_cost.empty() && tState::travel_cost.empty() ? "drops" : "cost");
+  std::cout << "--- audit of \"" << filename << "\", floors F = " << F << ", eggs E = " << E << " ---" << std::endl;
+  std::cout << "executions    = " << counts.executions << " (" << counts.steps << " steps)" << std::endl;
+  std::cout << "non-optimal   = " << counts.nonoptimal << " steps (" << counts.wasted << " wasted: outcome known or no eggs left)" << std::endl;
+  std::cout << "inconsistent  = " << counts.inconsistent << " executions" << std::endl;
+  std::cout << "out of eggs   = " << counts.exhausted << " executions" << std::endl;
+  std::cout << "incomplete    = " << counts.incomplete << " executions" << std::endl;
+  std::cout << "extra " << padded(unit, 8) << "= " << counts.extra << " over V = " << V.at(E, 0, F + 1)
+            << " (" << counts.over << " executions)" << std::endl;
+  std::cout << "duration      = " << clock_diff.count() << " s. (" << counts.steps / std::max(clock_diff.count(), 1e-9) * 60
+            << " steps per minute, threads = " << cfg.nthreads << ")" << std::endl;
+  if (generate > 0 && fault == 0.0 && (counts.executions != generate || counts.nonoptimal + counts.inconsistent + counts.exhausted + counts.incomplete + counts.over > 0)) {
+    std::cout << "audit of a fault-free log is inconsistent" << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+// Print the standard report (per-e summaries and the tables parsed by dpegg-demo.py) for solved tables V, A.
+// If the summed table S is available the means are looked up instead of simulated.
+// The unit is "drops", or "cost" when floor costs are in effect.
+template <typename TV, typename TA>
+int print_report(int F,
+                 int E,
+                 const TV& V,
+                 const TA& A,
+                 const tDense<long long>* S = nullptr,
+                 const std::string& unit = "drops")
+{
+  std::unordered_map<int, int> histo;
+  std::vector<std::vector<int>> drops;
+  int max_drops;
+  double mean_drops;
+
+  drops.emplace_back();
+
+  for (int e = 1; e <= E; e++) {
+
+    drops.emplace_back();
+
+    const bool looks_ok = check_policy(F, e, V, A, max_drops, mean_drops, &drops[e], &histo);
+
+    if (!looks_ok) {
+      std::cout << "DP solution is inconsistent (e = " << e << ")" << std::endl;
+      return 1;
+    }
+
+    std::cout << "--- floors F = " << F << ", eggs E = " << e << " ---" << std::endl;
+    std::cout << padded("min max " + unit, 14) << "= " << max_drops << " (optimal worst case)" << std::endl;
+    std::cout << padded("mean " + unit, 14) << "= " << mean_drops << " (uniform limit floor)" << std::endl;
+    if (unit == "drops") {
+      std::cout << "drops histg.  = " << histogram_to_string(histo, 0, max_drops) << std::endl;
+    } else {
+      std::vector<std::pair<int, int>> pairs(histo.begin(), histo.end());
+      std::sort(pairs.begin(), pairs.end());
+      std::cout << padded(unit + " histg.", 14) << "=";
+      for (const auto& p : pairs)
+        std::cout << " " << p.first << ":" << p.second;
+      std::cout << std::endl;
+    }
+
+    print_all_admissible({e, 0, F + 1}, V, &A, S);
+  }
+
+  std::cout << "--- min max " << unit << ", E = 1.." << E << " ---" << std::endl;
+  for (int f = 1; f <= F; f++) {
+    std::cout << "floors " << std::setw(3) << f << ": ";
+    for (int e = 1; e <= E; e++) {
+      int value = 0;
+      table_find(V, {e, 0, f + 1}, value);
+      std::cout << std::setw(3) << value << " ";
+    }
+    std::cout << std::endl;
+  }
+
+  // this table may not be monotonic in general (along F) unless --tiebreak is specified!
+  std::cout << "--- average " << unit << ", E = 1.." << E << " ---" << std::endl;
+  for (int f = 1; f <= F; f++) {
+    std::cout << "floors " << std::setw(3) << f << ": ";
+    for (int e = 1; e <= E; e++) {
+      if (S != nullptr)
+        mean_drops = static_cast<double>(S->at(e, 0, f + 1)) / (f + 1);
+      else
+        check_policy(f, e, V, A, max_drops, mean_drops);
+      std::cout << std::setw(8) << mean_drops << " ";
+    }
+    std::cout << std::endl;
+  }
+
+  std::cout << "--- drop histograms E = 1.." << E << " (F = " << F << ") ---" << std::endl;
+  for (int f = 1; f <= F; f++) {
+    std::cout << "floor  " << std::setw(3) << f << ": ";
+    for (int e = 1; e <= E; e++)
+      std::cout << std::setw(3) << drops[e][f] << " ";
+    std::cout << std::endl;
+  }
+
+  std::cout << "--- optimal E = " << E << " executions for all limit levels L ---" << std::endl;
+  for (int x = 0; x <= F; x++) {
+    std::vector<int> aseq;
+    int xsteps = run_policy_once(F, E, x, A, &aseq);
+    std::cout << "L = " << std::setw(3) << x << ": ";
+    for (int y : aseq)
+      std::cout << y << " ";
+    if (unit == "drops")
+      std::cout << "(" << xsteps << " steps)" << std::endl;
+    else
+      std::cout << "(" << aseq.size() << " steps, " << unit << " " << xsteps << ")" << std::endl;
+  }
+
+  if (tState::tolerance > 0)
+    return print_tolerance_savings(F, E, V);
 
   return 0;
 }
+
+/*****************************************************************************/
+
+int main(int argc, char** argv)
+{
+  if (argc < 3) {
+    std::cout << "usage: " << argv[0] << " F E [--tiebreak --left --right]" << std::endl;
+    std::cout << "       " << argv[0] << " F E [--cost-file=path | --cost-param=c0,c1,p] [--objective=minimax|mean] [--dense] [--threads=N]" << std::endl;
+    std::cout << "       " << argv[0] << " F E [--travel-file=path | --travel-param=c0,c1,p] [--objective=minimax|mean] [--threads=N]" << std::endl;
+    std::cout << "       " << argv[0] << " F E [--forbid=path | --forbid-random=fraction[,seed]] [--bench-forbidden [--seed=S]] ..." << std::endl;
+    std::cout << "       " << argv[0] << " F E --noise=p_break,p_survive [--trials=N --seed=S --threads=N]" << std::endl;
+    std::cout << "       " << argv[0] << " F E --droppers=k" << std::endl;
+    std::cout << "       " << argv[0] << " F E --damage=step[,cap]" << std::endl;
+    std::cout << "       " << argv[0] << " F E --crack=c[,keep]" << std::endl;
+    std::cout << "       " << argv[0] << " F E --lies=k" << std::endl;
+    std::cout << "       " << argv[0] << " F E --unbounded" << std::endl;
+    std::cout << "       " << argv[0] << " F E --lag=p [--threads=N]" << std::endl;
+    std::cout << "       " << argv[0] << " F E --stages=r" << std::endl;
+    std::cout << "       " << argv[0] << " F E --egg-cost=c [--buy-egg=price] [--egg-cost-sweep=lo,hi]" << std::endl;
+    std::cout << "       " << argv[0] << " F E --angles=A [--threads=N]" << std::endl;
+    std::cout << "       " << argv[0] << " F E --poset=chain|grid,A|tree,k|bench" << std::endl;
+    std::cout << "       " << argv[0] << " F E --buildings=F2,...,Fk" << std::endl;
+    std::cout << "       " << argv[0] << " F E --quantile=p [--prior=path] [--threads=N]" << std::endl;
+    std::cout << "       " << argv[0] << " F E --drop-budget=D [--prior=path] [--threads=N]" << std::endl;
+    std::cout << "       " << argv[0] << " F E --tolerance=k [standard, dense or cost model options]" << std::endl;
+    std::cout << "       " << argv[0] << " F E --prior-delta=path [--prior=path] [--threads=N]" << std::endl;
+    std::cout << "       " << argv[0] << " F E --prior-batch=path | --prior-random=K [--seed=S] [--threads=N]" << std::endl;
+    std::cout << "       " << argv[0] << " F E --tie-regret=path [--cost-file=path | --cost-param=c0,c1,p] [--threads=N]" << std::endl;
+    std::cout << "       " << argv[0] << " F E --mean-bounds [--threads=N]" << std::endl;
+    std::cout << "       " << argv[0] << " F E --policy-swap=N [--threads=N] [--seed=S]" << std::endl;
+    std::cout << "       " << argv[0] << " F E --surface=path[,wmax] [dense or cost model options]" << std::endl;
+    std::cout << "       " << argv[0] << " F E --audit=path [--audit-generate=N[,fault]] [--seed=S] [--threads=N]" << std::endl;
+    return 1;
+  }
+
+  const int F = as_integer(argv[1]);
+  const int E = as_integer(argv[2]);
+
+  if (F <= 0 || E <= 0) {
+    std::cout << "invalid input(s): F, E >= 1 required" << std::endl;
+    return 1;
+  }
+
+  bool use_tiebreak = false;
+  bool pick_left = false;
+  bool pick_right = false;
+  bool use_dense = false;
+  bool minimize_mean = false;
+  int nthreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  std::string cost_file;
+  std::string cost_param;
+  std::string travel_file;
+  std::string travel_param;
+  std::string forbid_file;
+  std::string forbid_random;
+  bool bench_forbid = false;
+  std::string noise_param;
+  long long trials = 100000;
+  unsigned int seed = 1;
+  int droppers = 0;
+  std::string damage_param;
+  std::string crack_param;
+  int lies = -1;
+  bool unbounded = false;
+  int lag = -1;
+  int stages = 0;
+  std::string egg_cost_param;
+  std::string buy_egg_param;
+  std::string egg_sweep_param;
+  int angles = 0;
+  std::string poset_param;
+  std::string buildings_param;
+  double quantile = 0.0;
+  std::string prior_file;
+  int drop_budget = -1;
+  std::string prior_delta_file;
+  std::string prior_batch_file;
+  int prior_random = 0;
+  std::string tie_regret_file;
+  bool mean_bounds = false;
+  int policy_swaps = 0;
+  std::string surface_param;
+  std::string audit_file;
+  std::string audit_generate;
+
+  for (int i = 3; i < argc; i++) {
+    const std::string arg(argv[i]);
+    std::string value;
+    if (arg == "--tiebreak")
+      use_tiebreak = true;
+    else if (arg == "--left")
+      pick_left = true;
+    else if (arg == "--right")
+      pick_right = true;
+    else if (arg == "--dense")
+      use_dense = true;
+    else if (option_value(arg, "--cost-file", cost_file) || option_value(arg, "--cost-param", cost_param))
+      use_dense = true;
+    else if (option_value(arg, "--travel-file", travel_file) || option_value(arg, "--travel-param", travel_param))
+      use_dense = true;
+    else if (option_value(arg, "--forbid", forbid_file) || option_value(arg, "--forbid-random", forbid_random))
+      use_dense = true;
+    else if (option_value(arg, "--policy-swap", value) && as_integer(value.c_str()) >= 1)
+      policy_swaps = as_integer(value.c_str());
+    else if (arg == "--mean-bounds")
+      mean_bounds = true;
+    else if (arg == "--unbounded")
+      unbounded = true;
+    else if (arg == "--bench-forbidden")
+      bench_forbid = true;
+    else if (option_value(arg, "--noise", noise_param))
+      {}  // the mode is dispatched after validation
+    else if (option_value(arg, "--trials", value) && std::atoll(value.c_str()) >= 1)
+      trials = std::atoll(value.c_str());
+    else if (option_value(arg, "--droppers", value) && as_integer(value.c_str()) >= 1)
+      droppers = as_integer(value.c_str());
+    else if (option_value(arg, "--egg-cost", egg_cost_param) || option_value(arg, "--buy-egg", buy_egg_param))
+      {}
+    else if (option_value(arg, "--egg-cost-sweep", egg_sweep_param))
+      {}
+    else if (option_value(arg, "--poset", poset_param))
+      {}
+    else if (option_value(arg, "--buildings", buildings_param))
+      {}
+    else if (option_value(arg, "--quantile", value) && std::atof(value.c_str()) > 0.0 && std::atof(value.c_str()) <= 1.0)
+      quantile = std::atof(value.c_str());
+    else if (option_value(arg, "--tolerance", value) && as_integer(value.c_str()) >= 0)
+      tState::tolerance = as_integer(value.c_str());
+    else if (option_value(arg, "--drop-budget", value) && as_integer(value.c_str()) >= 0)
+      drop_budget = as_integer(value.c_str());
+    else if (option_value(arg, "--prior-delta", prior_delta_file))
+      {}
+    else if (option_value(arg, "--prior-batch", prior_batch_file))
+      {}
+    else if (option_value(arg, "--tie-regret", tie_regret_file))
+      use_dense = true;
+    else if (option_value(arg, "--surface", surface_param))
+      use_dense = true;
+    else if (option_value(arg, "--audit-generate", audit_generate))
+      {}
+    else if (option_value(arg, "--audit", audit_file))
+      {}
+    else if (option_value(arg, "--prior-random", value) && as_integer(value.c_str()) >= 1)
+      prior_random = as_integer(value.c_str());
+    else if (option_value(arg, "--prior", prior_file))
+      {}
+    else if (option_value(arg, "--angles", value) && as_integer(value.c_str()) >= 1)
+      angles = as_integer(value.c_str());
+    else if (option_value(arg, "--stages", value) && as_integer(value.c_str()) >= 1)
+      stages = as_integer(value.c_str());
+    else if (option_value(arg, "--lag", value) && as_integer(value.c_str()) >= 0 && as_integer(value.c_str()) <= 8)
+      lag = as_integer(value.c_str());
+    else if (option_value(arg, "--lies", value) && as_integer(value.c_str()) >= 0 && as_integer(value.c_str()) <= 8)
+      lies = as_integer(value.c_str());
+    else if (option_value(arg, "--damage", damage_param) || option_value(arg, "--crack", crack_param))
+      {}
+    else if (option_value(arg, "--seed", value))
+      seed = static_cast<unsigned int>(as_integer(value.c_str()));
+    else if (option_value(arg, "--objective", value) && (value == "minimax" || value == "mean"))
+      minimize_mean = (value == "mean");
+    else if (option_value(arg, "--threads", value) && as_integer(value.c_str()) >= 1)
+      nthreads = as_integer(value.c_str());
+    else {
+      std::cout << "invalid input: \"" << argv[i] << "\"" << std::endl;
+      return 1;  
+    }
+  }
+
+  if (pick_left && pick_right) {
+    std::cout << "cannot specify both --left and --right" << std::endl;
+    return 1;
+  }
+
+  if (!cost_file.empty() && !cost_param.empty()) {
+    std::cout << "cannot specify both --cost-file and --cost-param" << std::endl;
+    return 1;
+  }
+
+  if (!travel_file.empty() && !travel_param.empty()) {
+    std::cout << "cannot specify both --travel-file and --travel-param" << std::endl;
+    return 1;
+  }
+
+  if (!tie_regret_file.empty() && (minimize_mean || !travel_file.empty() || !travel_param.empty())) {
+    std::cout << "--tie-regret requires the minimax objective and no travel costs" << std::endl;
+    return 1;
+  }
+
+  std::string surface_file = surface_param;
+  int surface_width = F + 1;
+  if (!surface_param.empty()) {
+    const size_t comma = surface_param.rfind(',');
+    if (comma != std::string::npos) {
+      surface_file = surface_param.substr(0, comma);
+      surface_width = as_integer(surface_param.substr(comma + 1).c_str());
+    }
+    if (surface_file.empty() || surface_width < 2 || !travel_file.empty() || !travel_param.empty()) {
+      std::cout << "invalid decision surface export \"" << surface_param << "\" (expected path[,wmax], no travel costs)" << std::endl;
+      return 1;
+    }
+  }
+
+  std::vector<double> audit_param;
+  if (!audit_generate.empty() && (audit_file.empty() || !parse_list(audit_generate, audit_param) || audit_param.size() > 2 ||
+                                  audit_param[0] < 1 || (audit_param.size() == 2 && (audit_param[1] < 0.0 || audit_param[1] > 1.0)))) {
+    std::cout << "invalid log generation \"" << audit_generate << "\" (expected N[,fault] together with --audit=path)" << std::endl;
+    return 1;
+  }
+
+  if (minimize_mean && !use_dense && audit_file.empty() && !mean_bounds && !bench_forbid && noise_param.empty()) {
+    std::cout << "--objective=mean requires the dense engine (--dense or a cost model)" << std::endl;
+    return 1;
+  }
+
+  if (!cost_file.empty() && !load_floor_costs(cost_file, F, tState::floor_cost)) {
+    std::cout << "failed to read " << F << " nonnegative floor costs from \"" << cost_file << "\"" << std::endl;
+    return 1;
+  }
+
+  std::vector<double> param;
+  if (!cost_param.empty() && !(parse_list(cost_param, param) && parametric_floor_costs(F, param, tState::floor_cost))) {
+    std::cout << "invalid cost parameters \"" << cost_param << "\" (expected c0,c1,p)" << std::endl;
+    return 1;
+  }
+
+  if (!travel_file.empty() && !load_floor_costs(travel_file, F, tState::travel_cost)) {
+    std::cout << "failed to read " << F << " nonnegative travel costs from \"" << travel_file << "\"" << std::endl;
+    return 1;
+  }
+
+  if (!travel_param.empty() && !(parse_list(travel_param, param) && parametric_floor_costs(F, param, tState::travel_cost))) {
+    std::cout << "invalid travel cost parameters \"" << travel_param << "\" (expected c0,c1,p)" << std::endl;
+    return 1;
+  }
+
+  if ((!tState::floor_cost.empty() || !tState::travel_cost.empty()) && !costs_fit_tables(F)) {
+    std::cout << "drop costs too large: F times the largest drop (plus travel) cost must stay below " << INT_MAX / 4 << std::endl;
+    return 1;
+  }
+
+  std::vector<double> prior;
+  if (!prior_file.empty() && !load_prior(prior_file, F, prior)) {
+    std::cout << "failed to read " << F + 1 << " nonnegative prior weights from \"" << prior_file << "\"" << std::endl;
+    return 1;
+  }
+
+  std::vector<std::pair<int, double>> prior_delta;
+  if (!prior_delta_file.empty() && !load_prior_delta(prior_delta_file, F, prior_delta)) {
+    std::cout << "failed to read \"floor weight\" pairs (floors 0.." << F << ") from \"" << prior_delta_file << "\"" << std::endl;
+    return 1;
+  }
+
+  std::vector<std::vector<double>> prior_batch;
+  if (!prior_batch_file.empty() && !load_prior_batch(prior_batch_file, F, prior_batch)) {
+    std::cout << "failed to read priors of " << F + 1 << " nonnegative weights from \"" << prior_batch_file << "\"" << std::endl;
+    return 1;
+  }
+
+  if (prior_random > 0) {
+    std::mt19937 rng(seed);
+    std::exponential_distribution<double> draw(1.0);
+    for (int k = 0; k < prior_random; k++) {
+      std::vector<double> weights(F + 1);
+      for (double& x : weights)
+        x = draw(rng);
+      const double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+      for (double& x : weights)
+        x /= total;
+      prior_batch.push_back(weights);
+    }
+  }
+
+  if (!forbid_file.empty() && !forbid_random.empty()) {
+    std::cout << "cannot specify both --forbid and --forbid-random" << std::endl;
+    return 1;
+  }
+
+  std::vector<int> forbidden;
+  if (!forbid_file.empty() && !load_forbidden_floors(forbid_file, F, forbidden)) {
+    std::cout << "failed to read forbidden floors (1.." << F << ") from \"" << forbid_file << "\"" << std::endl;
+    return 1;
+  }
+
+  if (!forbid_random.empty()) {
+    if (!parse_list(forbid_random, param) || param.size() > 2 || param[0] < 0.0 || param[0] > 1.0) {
+      std::cout << "invalid random forbidden set \"" << forbid_random << "\" (expected fraction[,seed])" << std::endl;
+      return 1;
+    }
+    random_forbidden_floors(F, param[0], param.size() > 1 ? static_cast<unsigned int>(param[1]) : 1, forbidden);
+  }
+
+  set_forbidden_floors(F, forbidden);
+
+  // parrot this call for later reference
+  for (int i = 0; i < argc; i++)
+    std::cout << argv[i] << " ";
+  std::cout << std::endl;
+
+  const bool unit_model = forbidden.empty() && tState::floor_cost.empty() && tState::travel_cost.empty();
+
+  if (tState::tolerance > 0) {
+    const bool special = unbounded || droppers > 0 || !buildings_param.empty() || quantile > 0.0 || drop_budget >= 0 ||
+                         !poset_param.empty() || angles > 0 || !egg_cost_param.empty() || !buy_egg_param.empty() ||
+                         !egg_sweep_param.empty() || stages > 0 || lag >= 0 || lies >= 0 || !crack_param.empty() ||
+                         !damage_param.empty() || !noise_param.empty() || bench_forbid;
+    if (special) {
+      std::cout << "--tolerance applies to the standard, dense and cost model engines only" << std::endl;
+      return 1;
+    }
+    std::cout << "--- tolerance: the limit floor is localized to within " << tState::tolerance + 1 << " floors" << std::endl;
+  }
+
+  if (unbounded) {
+    if (!unit_model) {
+      std::cout << "the unbounded mode requires unit costs and no forbidden floors" << std::endl;
+      return 1;
+    }
+    if (F > 1000000000) {
+      std::cout << "the unbounded mode reports f* up to F <= 10^9" << std::endl;
+      return 1;
+    }
+    return print_unbounded_report(F, E);
+  }
+
+  std::cout << "--- required min. number of drops = " << classic_dpegg_limit(F, E) << std::endl;
+
+  tDenseConfig cfg = {minimize_mean, use_tiebreak, pick_left, pick_right, 1, nthreads};
+  if (!tState::floor_cost.empty() || !tState::travel_cost.empty()) {
+    cfg.min_cost = 0;
+    if (!tState::floor_cost.empty())
+      cfg.min_cost += *std::min_element(tState::floor_cost.begin() + 1, tState::floor_cost.end());
+    if (!tState::travel_cost.empty())
+      cfg.min_cost += *std::min_element(tState::travel_cost.begin() + 1, tState::travel_cost.end());
+  }
+
+  if (droppers > 0) {
+    if (!unit_model) {
+      std::cout << "parallel droppers require unit costs and no forbidden floors" << std::endl;
+      return 1;
+    }
+    return print_rounds_report(F, E, droppers);
+  }
+
+  if (!audit_file.empty()) {
+    if (!tState::travel_cost.empty()) {
+      std::cout << "the audit replays the dense engine; travel costs are not supported" << std::endl;
+      return 1;
+    }
+    return print_audit_report(F, E, cfg, audit_file, audit_param.empty() ? 0 : static_cast<long long>(audit_param[0]),
+                              audit_param.size() == 2 ? audit_param[1] : 0.0, seed);
+  }
+
+  if (policy_swaps > 0) {
+    if (!unit_model) {
+      std::cout << "the policy swap demo requires unit costs and no forbidden floors" << std::endl;
+      return 1;
+    }
+    return print_policy_swap_report(F, E, policy_swaps, cfg, nthreads, seed);
+  }
+
+  if (mean_bounds) {
+    if (!unit_model || tState::tolerance > 0) {
+      std::cout << "the mean bounds require unit costs, no forbidden floors and no tolerance" << std::endl;
+      return 1;
+    }
+    return print_mean_bounds_report(F, E, cfg);
+  }
+
+  if (!prior_batch.empty()) {
+    if (!unit_model) {
+      std::cout << "the prior batch requires unit costs and no forbidden floors" << std::endl;
+      return 1;
+    }
+    return print_prior_batch_report(F, E, prior_batch, nthreads);
+  }
+
+  if (!prior_delta.empty()) {
+    if (!unit_model) {
+      std::cout << "the prior update requires unit costs and no forbidden floors" << std::endl;
+      return 1;
+    }
+    return print_prior_update_report(F, E, prior, prior_delta, nthreads);
+  }
+
+  if (quantile > 0.0 || drop_budget >= 0) {
+    if (!unit_model || F > 500) {
+      std::cout << "the quantile and drop budget objectives require unit costs, no forbidden floors and F <= 500" << std::endl;
+      return 1;
+    }
+    if (drop_budget >= 0)
+      return print_budget_report(F, E, drop_budget, prior, nthreads);
+    return print_quantile_report(F, E, quantile, prior, nthreads);
+  }
+
+  if (!buildings_param.empty()) {
+    std::vector<double> more;
+    std::vector<int> floors = {F};
+    if (!unit_model || !parse_list(buildings_param, more)) {
+      std::cout << "--buildings expects a list of floor counts and unit costs" << std::endl;
+      return 1;
+    }
+    long long cells = static_cast<long long>(F + 2) * (E + 1);
+    for (double f : more) {
+      if (f < 1 || f != std::floor(f)) {
+        std::cout << "--buildings expects positive floor counts" << std::endl;
+        return 1;
+      }
+      floors.push_back(static_cast<int>(f));
+      cells = std::max(cells, static_cast<long long>(f + 2) * (E + 1));
+    }
+    if (cells > 50000000) {
+      std::cout << "buildings too large for the carried-over search" << std::endl;
+      return 1;
+    }
+    return print_buildings_report(floors, E);
+  }
+
+  if (!poset_param.empty()) {
+    if (!unit_model) {
+      std::cout << "the poset model requires unit costs and no forbidden floors" << std::endl;
+      return 1;
+    }
+    const int result = run_poset(poset_param, F, E);
+    if (result < 0)
+      std::cout << "invalid poset \"" << poset_param << "\" (expected chain, grid,A, tree,k or bench with at most 64 configurations)" << std::endl;
+    return result != 0 ? 1 : 0;
+  }
+
+  if (angles > 0) {
+    if (!unit_model || std::max(F, angles) + 1 > GRID_MAX_SIDE) {
+      std::cout << "the 2D threshold search requires unit costs, no forbidden floors and F, A <= 13" << std::endl;
+      return 1;
+    }
+    return print_grid_report(F, angles, E, nthreads);
+  }
+
+  if (!egg_cost_param.empty() || !egg_sweep_param.empty()) {
+    std::vector<double> sweep;
+    std::vector<double> buy;
+    if (!parse_list(egg_cost_param.empty() ? "0" : egg_cost_param, param) || param.size() != 1 || param[0] < 0.0 ||
+        (!buy_egg_param.empty() && (!parse_list(buy_egg_param, buy) || buy.size() != 1 || buy[0] < 0.0)) ||
+        (!egg_sweep_param.empty() && (!parse_list(egg_sweep_param, sweep) || sweep.size() != 2 || sweep[0] < 0.0 || sweep[1] <= sweep[0]))) {
+      std::cout << "invalid economic parameters (expected --egg-cost=c, --buy-egg=price, --egg-cost-sweep=lo,hi)" << std::endl;
+      return 1;
+    }
+    if (!unit_model) {
+      std::cout << "the economic objective requires unit costs and no forbidden floors" << std::endl;
+      return 1;
+    }
+    return print_economic_report(F, E, param[0], buy.empty() ? -1.0 : buy[0], sweep.empty() ? -1.0 : sweep[0],
+                                 sweep.empty() ? -1.0 : sweep[1]);
+  }
+
+  if (stages > 0) {
+    if (!unit_model || static_cast<double>(stages + 1) * (std::min(E, F) + 1) * (F + 1) > 5e8) {
+      std::cout << "staged schedules require unit costs, no forbidden floors and (r + 1) (E + 1) (F + 1) <= 5 10^8" << std::endl;
+      return 1;
+    }
+    return print_stages_report(F, std::min(E, F), stages);
+  }
+
+  if (lag >= 0) {
+    double states = E + 1;
+    for (int i = 0; i <= lag; i++)
+      states *= F + 2;
+    if (!unit_model || states > 1e9) {
+      std::cout << "delayed feedback requires unit costs, no forbidden floors and (E + 1) (F + 2)^(p + 1) <= 10^9" << std::endl;
+      return 1;
+    }
+    return print_pipeline_report(F, E, lag, nthreads);
+  }
+
+  if (lies >= 0) {
+    if (!unit_model) {
+      std::cout << "the liar model requires unit costs and no forbidden floors" << std::endl;
+      return 1;
+    }
+    return print_liar_report(F, lies);
+  }
+
+  if (!crack_param.empty()) {
+    if (!parse_list(crack_param, param) || param.size() > 2 || param[0] < 0 || (param.size() == 2 && param[1] != 0 && param[1] != 1)) {
+      std::cout << "invalid crack band \"" << crack_param << "\" (expected c[,keep] with keep 0 or 1)" << std::endl;
+      return 1;
+    }
+    if (!unit_model) {
+      std::cout << "three-outcome drops require unit costs and no forbidden floors" << std::endl;
+      return 1;
+    }
+    return print_ternary_report(F, E, static_cast<int>(param[0]), param.size() == 2 && param[1] == 1);
+  }
+
+  if (!damage_param.empty()) {
+    if (!parse_list(damage_param, param) || param.size() > 2 || param[0] < 0 || (param.size() == 2 && (param[1] < 0 || param[1] > 7))) {
+      std::cout << "invalid damage \"" << damage_param << "\" (expected step[,cap] with cap <= 7)" << std::endl;
+      return 1;
+    }
+    if (E > 15 || F > 65534 || !unit_model) {
+      std::cout << "the damage model requires E <= 15, F <= 65534, unit costs and no forbidden floors" << std::endl;
+      return 1;
+    }
+    return print_damage_report(F, E, static_cast<int>(param[0]), param.size() == 2 ? static_cast<int>(param[1]) : E);
+  }
+
+  if (bench_forbid) {
+    bench_forbidden(F, E, cfg, seed);
+    return 0;
+  }
+
+  if (!forbidden.empty())
+    std::cout << "--- " << forbidden.size() << " forbidden drop floors" << std::endl;
+
+  if (!noise_param.empty()) {
+    if (!parse_list(noise_param, param) || param.size() != 2 || 
+        param[0] < 0.0 || param[0] >= 1.0 || param[1] < 0.0 || param[1] >= 1.0) {
+      std::cout << "invalid noise \"" << noise_param << "\" (expected p_break,p_survive in [0, 1))" << std::endl;
+      return 1;
+    }
+    if (!tState::floor_cost.empty() || !tState::travel_cost.empty()) {
+      std::cout << "noisy drops are counted in drops; cost models are not supported" << std::endl;
+      return 1;
+    }
+    const tNoise noise = {param[0], param[1]};
+
+    tDense<double> Vn;
+    tDense<int> An;
+    tDense<int> V;
+    tDense<int> A;
+    tDense<long long> S;
+
+    auto clock_start = std::chrono::high_resolution_clock::now();
+    noisy_scan(F, E, noise, cfg, Vn, An);
+    dense_scan(F, E, cfg, V, A, S);
+    auto clock_end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> clock_diff = clock_end - clock_start;
+
+    std::cout << std::setprecision(6);
+    std::cout << "noisy and minimax tables solved (duration = " << clock_diff.count() << " s.)" << std::endl;
+
+    for (int e = 1; e <= E; e++) {
+      std::cout << "--- floors F = " << F << ", eggs E = " << e << ", noise = " << noise.false_break 
+                << "/" << noise.false_survive << ", trials = " << trials << " ---" << std::endl;
+      std::cout << "expected drops = " << Vn.at(e, 0, F + 1) << " (noisy policy, interval belief)" << std::endl;
+      std::cout << "min max drops  = " << V.at(e, 0, F + 1) << " (minimax policy, noise free)" << std::endl;
+      tMonteCarlo mc;
+      clock_start = std::chrono::high_resolution_clock::now();
+      monte_carlo_policy(F, e, An, noise, trials, seed, nthreads, mc);
+      print_monte_carlo("noisy policy  ", mc);
+      monte_carlo_policy(F, e, A, noise, trials, seed, nthreads, mc);
+      print_monte_carlo("minimax policy", mc);
+      clock_end = std::chrono::high_resolution_clock::now();
+      clock_diff = clock_end - clock_start;
+      std::cout << "monte carlo duration = " << clock_diff.count() << " s. (threads = " << nthreads << ")" << std::endl;
+    }
+    return 0;
+  }
+
+  if (!tState::travel_cost.empty()) {
+    tSided<int> V;
+    tSided<int> A;
+    tSided<long long> S;
+
+    auto clock_start = std::chrono::high_resolution_clock::now();
+    travel_scan(F, E, cfg, V, A, S, 1);
+    auto clock_end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> clock_diff = clock_end - clock_start;
+
+    std::cout << std::setprecision(6);
+
+    std::cout << "travel value (action) table has " << V.size() << " (" << A.size() 
+              << ") entries (threads = " << nthreads << ", duration = " << clock_diff.count() << " s.)" << std::endl;
+
+    return print_report(F, E, V, A, nullptr, "cost");
+  }
+
+  if (use_dense) {
+    tDense<int> V;
+    tDense<int> A;
+    tDense<long long> S;
+
+    auto clock_start = std::chrono::high_resolution_clock::now();
+    dense_scan(F, E, cfg, V, A, S, 1);
+    auto clock_end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> clock_diff = clock_end - clock_start;
+
+    std::cout << std::setprecision(6);
+
+    std::cout << "dense value (action) table has " << V.size() << " (" << A.size() 
+              << ") entries (threads = " << nthreads << ", duration = " << clock_diff.count() << " s.)" << std::endl;
+
+    if (!tie_regret_file.empty())
+      return print_tie_regret_report(F, E, cfg, V, S, tie_regret_file);
+
+    if (!surface_file.empty())
+      return print_surface_report(F, E, surface_width, cfg, V, S, surface_file);
+
+    return print_report(F, E, V, A, &S, tState::floor_cost.empty() ? "drops" : "cost");
+  }
+
+  std::unordered_map<tState, int> V; // "value function"
+  std::unordered_map<tState, int> A; // "control action"
+
+  auto clock_start = std::chrono::high_resolution_clock::now();
+
+  initialize_terminal_nodes(F, E, V);
+ 
+  for (int e = 1; e <= E; e++) {
+    for (int s = 0; ; s++) {
+      int inserts = 0;
+      int modifies = 0;
+      single_scan(F, e, e, V, A, inserts, modifies, use_tiebreak, pick_left, pick_right);
+      //std::cout << "[e = " << e << ", scan = " << s << "]: " << "inserts = " << inserts << ", modifies = " << modifies << std::endl;
+      if (inserts == 0 && modifies == 0) {
+        std::cout << s + 1 << " scans at level e = " << e << std::endl;
+        break;
+      }
+    }
+  }
+
+  auto clock_end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> clock_diff = clock_end - clock_start;
+
+  std::cout << std::setprecision(6);
+
+  std::cout << "value (action) table has " << V.size() << " (" << A.size() 
+            << ") entries (duration = " << clock_diff.count() << " s.)" << std::endl;
+
+  return print_report(F, E, V, A);
+}